@@ -0,0 +1,225 @@
+//
+//  Benchmark.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Minimal harness in the spirit of Google Benchmark: every benchmark runs
+//  its body with a growing iteration count until it takes at least
+//  --min-time seconds, and the results are written as Google Benchmark
+//  compatible JSON (name, iterations, real_time in ns/op, bytes_per_second,
+//  items_per_second and user counters) so runs of different versions can be
+//  compared.
+//
+
+#ifndef Benchmark_hpp
+#define Benchmark_hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Keeps the compiler from dropping a computation whose result is unused.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+// Bumped by an allocation observer when the benchmark binary links
+// AllocationCounting.cpp and sets one (see BenchmarkSuite.cpp) along with
+// allocationsCounted; every result then carries an
+// allocations_per_iteration counter.
+inline std::atomic<size_t> allocationCount {0};
+inline bool allocationsCounted = false;
+
+class BenchmarkState {
+private:
+    size_t iterations;
+    size_t bytesProcessed = 0;
+    size_t itemsProcessed = 0;
+    std::map<std::string, double> counters;
+public:
+    BenchmarkState(size_t iterations): iterations(iterations) {};
+
+    size_t iterationCount() const { return iterations; }
+
+    // Totals for the whole run, not per iteration.
+    void setBytesProcessed(size_t bytes) { bytesProcessed = bytes; }
+    void setItemsProcessed(size_t items) { itemsProcessed = items; }
+
+    // Reported as is, e.g. an error measured alongside the timing.
+    void setCounter(const std::string& name, double value) { counters[name] = value; }
+
+    size_t getBytesProcessed() const { return bytesProcessed; }
+    size_t getItemsProcessed() const { return itemsProcessed; }
+    const std::map<std::string, double>& getCounters() const { return counters; }
+};
+
+typedef std::function<void(BenchmarkState&)> BenchmarkBody;
+
+struct Benchmark {
+    std::string name;
+    BenchmarkBody body;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations;
+    double nanosecondsPerIteration;
+    double bytesPerSecond;
+    double itemsPerSecond;
+    std::map<std::string, double> counters;
+};
+
+// MARK: - Running
+
+inline BenchmarkResult runBenchmark(const Benchmark& benchmark, double minimalSeconds) {
+    size_t iterations = 1;
+
+    while (true) {
+        BenchmarkState state (iterations);
+        size_t allocations = allocationCount.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        benchmark.body(state);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        allocations = allocationCount.load(std::memory_order_relaxed) - allocations;
+
+        if (seconds >= minimalSeconds || iterations >= (size_t(1) << 40)) {
+            auto counters = state.getCounters();
+            if (allocationsCounted) {
+                counters["allocations_per_iteration"] = double(allocations) / iterations;
+            }
+            return BenchmarkResult {
+                benchmark.name,
+                iterations,
+                seconds * 1e9 / iterations,
+                state.getBytesProcessed() / seconds,
+                state.getItemsProcessed() / seconds,
+                counters
+            };
+        }
+
+        double scale = seconds > 0 ? minimalSeconds * 1.4 / seconds : 10.0;
+        scale = scale > 10.0 ? 10.0 : (scale < 2.0 ? 2.0 : scale);
+        iterations = static_cast<size_t>(iterations * scale) + 1;
+    }
+}
+
+// MARK: - Reporting
+
+inline std::string benchmarkDate() {
+    char buffer[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    return buffer;
+}
+
+inline std::string benchmarkJson(const std::vector<BenchmarkResult>& results) {
+    std::ostringstream json;
+    json.precision(6);
+    json << std::fixed;
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+
+    json << "{\n";
+    json << "  \"context\": {\n";
+    json << "    \"date\": \"" << benchmarkDate() << "\",\n";
+    json << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    json << "    \"library_build_type\": \"" << buildType << "\"\n";
+    json << "  },\n";
+    json << "  \"benchmarks\": [";
+    for (size_t index = 0; index < results.size(); ++index) {
+        const auto& result = results[index];
+        json << (index == 0 ? "\n" : ",\n");
+        json << "    {\n";
+        json << "      \"name\": \"" << result.name << "\",\n";
+        json << "      \"run_type\": \"iteration\",\n";
+        json << "      \"iterations\": " << result.iterations << ",\n";
+        json << "      \"real_time\": " << result.nanosecondsPerIteration << ",\n";
+        json << "      \"time_unit\": \"ns\"";
+        if (result.bytesPerSecond > 0) {
+            json << ",\n      \"bytes_per_second\": " << result.bytesPerSecond;
+        }
+        if (result.itemsPerSecond > 0) {
+            json << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        }
+        for (const auto& counter: result.counters) {
+            json << ",\n      \"" << counter.first << "\": " << std::scientific << counter.second << std::fixed;
+        }
+        json << "\n    }";
+    }
+    json << "\n  ]\n}\n";
+
+    return json.str();
+}
+
+// Arguments: --filter=<substring> --min-time=<seconds> --out=<file.json>
+// JSON goes to the file or stdout, a readable table to stderr.
+inline int runBenchmarks(const std::vector<Benchmark>& benchmarks, int argc, char* argv[]) {
+    std::string filter;
+    std::string output;
+    double minimalSeconds = 0.1;
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        if (argument.rfind("--filter=", 0) == 0) {
+            filter = argument.substr(9);
+        } else if (argument.rfind("--min-time=", 0) == 0) {
+            minimalSeconds = std::stod(argument.substr(11));
+        } else if (argument.rfind("--out=", 0) == 0) {
+            output = argument.substr(6);
+        } else {
+            std::cerr << "Unknown argument " << argument << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& benchmark: benchmarks) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        auto result = runBenchmark(benchmark, minimalSeconds);
+        std::fprintf(stderr, "%-48s %14.2f ns/op", result.name.c_str(), result.nanosecondsPerIteration);
+        if (result.bytesPerSecond > 0) {
+            std::fprintf(stderr, " %10.2f MB/s", result.bytesPerSecond / 1e6);
+        }
+        for (const auto& counter: result.counters) {
+            std::fprintf(stderr, " %s=%.3g", counter.first.c_str(), counter.second);
+        }
+        std::fprintf(stderr, "\n");
+        results.push_back(result);
+    }
+
+    auto json = benchmarkJson(results);
+    if (output.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file (output);
+        if (!file) {
+            std::cerr << "Can't open " << output << "\n";
+            return 1;
+        }
+        file << json;
+    }
+    return 0;
+}
+
+#endif /* Benchmark_hpp */
@@ -0,0 +1,858 @@
+//
+//  BenchmarkSuite.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Tokenizer throughput, every FlowProcessor::process overload, the
+//  expression cache, the staged pipeline, every Calculator operation and
+//  parsed jobs evaluated in parallel per thread count, the ComplexNumber / ComplexArray arithmetic, the polar batch kernels, chains
+//  of products and powers in cartesian and lazy polar form, the column
+//  reader against stream extraction, complex streams against text both
+//  ways and throughput and accuracy per precision tier. Allocations are
+//  counted through AllocationCounting.cpp's operator new, so every benchmark
+//  also reports allocations_per_iteration.
+//  Build: cmake --build <build directory> --target benchmark
+//  Run:
+//    ./benchmark --out=results.json [--filter=Tokenizer] [--min-time=0.5]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "../Source-ComplexNumber/AllocationCounting.hpp"
+#include "../Source-ComplexNumber/Batch.hpp"
+#include "../Source-ComplexNumber/Calculator.hpp"
+#include "../Source-ComplexNumber/ColumnReader.hpp"
+#include "../Source-ComplexNumber/ComplexArray.hpp"
+#include "../Source-ComplexNumber/ComplexStream.hpp"
+#include "../Source-ComplexNumber/Expression.hpp"
+#include "../Source-ComplexNumber/FlowProcessor.hpp"
+#include "../Source-ComplexNumber/Pipeline.hpp"
+#include "../Source-ComplexNumber/PolarNumber.hpp"
+#include "../Source-ComplexNumber/RequestArena.hpp"
+#include "../Source-ComplexNumber/ThreadPool.hpp"
+#include "../Source-ComplexNumber/Tokenizer.hpp"
+
+// MARK: - Inputs
+
+std::string makeExpressionLine(size_t length) {
+    const std::string pattern = "2+i3 * -i4.25 modulus 12.5-i0.75 / B ";
+    std::string input;
+    while (input.size() < length) {
+        input += pattern;
+    }
+    input.resize(length);
+    return input;
+}
+
+ComplexArray makeComplexArray(size_t size) {
+    ComplexArray array (size);
+    for (size_t index = 0; index < size; ++index) {
+        array.set(index, ComplexNumber(index * 0.5 - 100.0, 3.0 - index * 0.25));
+    }
+    return array;
+}
+
+std::string simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return "scalar";
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+std::string accuracyName(ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return "full";
+        case ArgumentAccuracy::FAST:
+            return "fast";
+        case ArgumentAccuracy::COARSE:
+            return "coarse";
+    }
+    return "unknown";
+}
+
+// MARK: - Tokenizer
+
+void addTokenizerBenchmarks(std::vector<Benchmark>& benchmarks) {
+    for (size_t length: {16, 64, 256, 1024, 4096, 16384}) {
+        benchmarks.push_back({"Tokenizer/tokenize/" + std::to_string(length), [length](BenchmarkState& state) {
+            auto input = makeExpressionLine(length);
+            Tokenizer tokenizer;
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto tokens = tokenizer.tokenize(input);
+                doNotOptimize(tokens);
+            }
+            state.setBytesProcessed(state.iterationCount() * length);
+        }});
+        benchmarks.push_back({"Tokenizer/tokenize/arena/" + std::to_string(length), [length](BenchmarkState& state) {
+            auto input = makeExpressionLine(length);
+            Tokenizer tokenizer;
+            RequestArena arena (1 << 20);
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                arena.reset();
+                auto tokens = tokenizer.tokenize(input, arena.resource());
+                doNotOptimize(tokens);
+            }
+            state.setBytesProcessed(state.iterationCount() * length);
+        }});
+    }
+}
+
+// MARK: - Flow Processor
+
+template <typename Step>
+Benchmark makeFlowBenchmark(std::string name, std::string input) {
+    return {"FlowProcessor/process/" + name, [input](BenchmarkState& state) {
+        auto tokens = Tokenizer().tokenize(input);
+        FlowProcessor processor;
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto result = processor.process(Flow<Step>(tokens));
+            doNotOptimize(result);
+        }
+        state.setBytesProcessed(state.iterationCount() * input.size());
+    }};
+}
+
+void addFlowProcessorBenchmarks(std::vector<Benchmark>& benchmarks) {
+    benchmarks.push_back(makeFlowBenchmark<ComplexOperand>("ComplexOperand", "2.5+i3.75"));
+    benchmarks.push_back(makeFlowBenchmark<DoubleOperand>("DoubleOperand", "12.125"));
+    benchmarks.push_back(makeFlowBenchmark<Operation>("Operation/operator", " * "));
+    benchmarks.push_back(makeFlowBenchmark<Operation>("Operation/function", "modulus"));
+    benchmarks.push_back(makeFlowBenchmark<Menu>("Menu", "B"));
+
+    // Long rejected lines: filtering must stay linear in the token count.
+    for (size_t count: {64, 1024, 16384}) {
+        std::string line;
+        for (size_t index = 0; index < count; ++index) {
+            line += "1 ";
+        }
+        benchmarks.push_back(makeFlowBenchmark<ComplexOperand>("ComplexOperand/tokens:" + std::to_string(count), line));
+    }
+
+    for (std::string line: {"2+i3 * 4", "1-i2 modulus", "2+i3 + 1-i1"}) {
+        benchmarks.push_back({"BatchEvaluator/evaluate/" + line, [line](BenchmarkState& state) {
+            BatchEvaluator evaluator (0);
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto result = evaluator.evaluate(line);
+                doNotOptimize(result);
+            }
+            state.setBytesProcessed(state.iterationCount() * line.size());
+        }});
+    }
+}
+
+// MARK: - Expression Cache
+
+// Cycles through distinct lines, so that with a capacity below
+// lineCount every lookup misses and evicts.
+Benchmark makeCacheBenchmark(size_t lineCount, size_t capacity) {
+    auto name = "ExpressionCache/BatchEvaluator/lines:" + std::to_string(lineCount) + "/capacity:" + std::to_string(capacity);
+    return {name, [lineCount, capacity](BenchmarkState& state) {
+        std::vector<std::string> lines;
+        for (size_t index = 0; index < lineCount; ++index) {
+            lines.push_back(std::to_string(index) + "+i3 * " + std::to_string(index % 7 + 1));
+        }
+        BatchEvaluator evaluator (capacity);
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto result = evaluator.evaluate(lines[iteration % lineCount]);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }};
+}
+
+void addExpressionCacheBenchmarks(std::vector<Benchmark>& benchmarks) {
+    benchmarks.push_back(makeCacheBenchmark(64, 0));
+    benchmarks.push_back(makeCacheBenchmark(64, 4096));
+    benchmarks.push_back(makeCacheBenchmark(8192, 4096));
+
+    const std::string line = "(2+i3)*(1-i)/4 + modulus(3+i4) - arg(-1+i) * (0.5-i2.25)";
+    for (size_t capacity: {0, 4096}) {
+        benchmarks.push_back({"ExpressionCache/ExpressionEvaluator/capacity:" + std::to_string(capacity), [line, capacity](BenchmarkState& state) {
+            ExpressionEvaluator evaluator (capacity);
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto result = evaluator.evaluate(line);
+                doNotOptimize(result);
+            }
+            state.setBytesProcessed(state.iterationCount() * line.size());
+        }});
+    }
+}
+
+// MARK: - Expression
+
+void addExpressionBenchmarks(std::vector<Benchmark>& benchmarks) {
+    const std::string line = "(2+i3)*(1-i)/4 + modulus(3+i4) - arg(-1+i) * (0.5-i2.25)";
+
+    benchmarks.push_back({"ExpressionCompiler/compile", [line](BenchmarkState& state) {
+        Tokenizer tokenizer;
+        ExpressionCompiler compiler;
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto expression = compiler.compile(tokenizer.tokenize(line));
+            doNotOptimize(expression);
+        }
+        state.setBytesProcessed(state.iterationCount() * line.size());
+    }});
+
+    const std::string chain = "(1+i2) power 0.5 * (3-i) / (2+i) power 3 * (0.5+i0.25) power 1.5 / (1-i3) root 3";
+    for (auto program: {std::make_pair(std::string("CompiledExpression/evaluate"), line), std::make_pair(std::string("CompiledExpression/evaluate/chain"), chain)}) {
+        benchmarks.push_back({program.first, [program](BenchmarkState& state) {
+            auto expression = ExpressionCompiler().compile(program.second).success();
+            std::vector<LazyComplexNumber> stack;
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto result = expression.evaluate(stack);
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount());
+        }});
+    }
+}
+
+// MARK: - Pipeline
+
+void addPipelineBenchmarks(std::vector<Benchmark>& benchmarks) {
+    const size_t lineCount = 1 << 16;
+    std::string input;
+    for (size_t index = 0; index < lineCount; ++index) {
+        input += std::to_string(index % 97) + ".5-i" + std::to_string(index % 13) + (index % 2 == 0 ? " * 3\n" : " + 1+i2\n");
+    }
+
+    benchmarks.push_back({"Pipeline/sequential", [input, lineCount](BenchmarkState& state) {
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            std::istringstream stream (input);
+            std::ostringstream output;
+            Batch(BatchMode::OPERATION, 0).run(stream, output);
+            doNotOptimize(output);
+        }
+        state.setItemsProcessed(state.iterationCount() * lineCount);
+        state.setBytesProcessed(state.iterationCount() * input.size());
+    }});
+
+    benchmarks.push_back({"Pipeline/pipelined", [input, lineCount](BenchmarkState& state) {
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            std::istringstream stream (input);
+            std::ostringstream output;
+            Pipeline<double>().run(stream, output);
+            doNotOptimize(output);
+        }
+        state.setItemsProcessed(state.iterationCount() * lineCount);
+        state.setBytesProcessed(state.iterationCount() * input.size());
+    }});
+
+    // The path --mmap takes once the file is mapped.
+    benchmarks.push_back({"Pipeline/inMemoryChunks", [input, lineCount](BenchmarkState& state) {
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            std::ostringstream output;
+            Batch(BatchMode::OPERATION, 0).run(std::string_view(input), output);
+            doNotOptimize(output);
+        }
+        state.setItemsProcessed(state.iterationCount() * lineCount);
+        state.setBytesProcessed(state.iterationCount() * input.size());
+    }});
+}
+
+// MARK: - Calculator
+
+const size_t operandCount = 1024;
+
+std::vector<ComplexNumber> makeOperands() {
+    std::vector<ComplexNumber> operands;
+    for (size_t index = 0; index < operandCount; ++index) {
+        operands.push_back(ComplexNumber(index * 0.5 - 100.0, 3.0 - index * 0.25));
+    }
+    return operands;
+}
+
+Benchmark makeFunctionBenchmark(std::string name, Function method) {
+    return {"Calculator/calculate/" + name, [method](BenchmarkState& state) {
+        auto operands = makeOperands();
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto result = Calculator::calculate(operands[iteration % operandCount], method);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }};
+}
+
+Benchmark makeBinaryBenchmark(std::string name, BinaryComplexOperation operation) {
+    return {"Calculator/calculate/" + name, [operation](BenchmarkState& state) {
+        auto operands = makeOperands();
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto pair = std::make_pair(operands[iteration % operandCount], operands[(iteration + 1) % operandCount]);
+            auto result = Calculator::calculate(pair, operation);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }};
+}
+
+Benchmark makeMixedBenchmark(std::string name, BinaryComplexDoubleOperation operation) {
+    return {"Calculator/calculate/" + name, [operation](BenchmarkState& state) {
+        auto operands = makeOperands();
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto pair = std::make_pair(operands[iteration % operandCount], 1.5 + (iteration % 7));
+            auto result = Calculator::calculate(pair, operation);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }};
+}
+
+Benchmark makeComplexFunctionBenchmark(std::string name, Function function) {
+    return {"Calculator/calculate/" + name, [function](BenchmarkState& state) {
+        auto operands = makeOperands();
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto pair = std::make_pair(operands[iteration % operandCount] / 64.0, 0.5 + (iteration % 7));
+            auto result = Calculator::calculate(pair, function);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }};
+}
+
+// Parsed jobs of every kind, as BasicBatchEvaluator::parse makes them.
+std::vector<CalculationJob> makeJobs(size_t count) {
+    auto operands = makeOperands();
+    std::vector<CalculationJob> jobs;
+    jobs.reserve(count);
+    for (size_t index = 0; index < count; ++index) {
+        auto first = operands[index % operandCount] / 64.0;
+        auto second = operands[(index + 1) % operandCount];
+        switch (index % 5) {
+            case 0:
+                jobs.emplace_back(first, BinaryComplexOperation::PLUS, second);
+                break;
+            case 1:
+                jobs.emplace_back(first, BinaryComplexDoubleOperation::DIVIDE, 1.5 + (index % 7));
+                break;
+            case 2:
+                jobs.emplace_back(first, Function::MODULUS);
+                break;
+            case 3:
+                jobs.emplace_back(first, Function::POWER, 0.5 + (index % 7));
+                break;
+            default:
+                jobs.emplace_back(first, Function::LOGARITHM);
+                break;
+        }
+    }
+    return jobs;
+}
+
+// The whole batch per iteration, with the pool made once outside.
+Benchmark makeJobsBenchmark(size_t threadCount) {
+    return {"Calculator/evaluate/jobs:16384/threads:" + std::to_string(threadCount), [threadCount](BenchmarkState& state) {
+        auto jobs = makeJobs(16384);
+        ThreadPool pool (threadCount);
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto results = evaluate(jobs, pool, 1024);
+            doNotOptimize(results);
+        }
+        state.setItemsProcessed(state.iterationCount() * jobs.size());
+    }};
+}
+
+void addCalculatorBenchmarks(std::vector<Benchmark>& benchmarks) {
+    benchmarks.push_back(makeFunctionBenchmark("MODULUS", Function::MODULUS));
+    benchmarks.push_back(makeFunctionBenchmark("ARGUMENT", Function::ARGUMENT));
+    benchmarks.push_back(makeComplexFunctionBenchmark("POWER", Function::POWER));
+    benchmarks.push_back(makeComplexFunctionBenchmark("ROOT", Function::ROOT));
+    benchmarks.push_back(makeComplexFunctionBenchmark("EXPONENT", Function::EXPONENT));
+    benchmarks.push_back(makeComplexFunctionBenchmark("LOGARITHM", Function::LOGARITHM));
+    benchmarks.push_back(makeBinaryBenchmark("PLUS", BinaryComplexOperation::PLUS));
+    benchmarks.push_back(makeBinaryBenchmark("MINUS", BinaryComplexOperation::MINUS));
+    benchmarks.push_back(makeMixedBenchmark("MULTIPLY", BinaryComplexDoubleOperation::MULTIPLY));
+    benchmarks.push_back(makeMixedBenchmark("DIVIDE", BinaryComplexDoubleOperation::DIVIDE));
+
+    // Scaling with the thread count, up to one thread per core.
+    size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    for (size_t threadCount = 1; threadCount < cores; threadCount *= 2) {
+        benchmarks.push_back(makeJobsBenchmark(threadCount));
+    }
+    benchmarks.push_back(makeJobsBenchmark(cores));
+}
+
+// MARK: - Complex Number
+
+template <typename Body>
+Benchmark makeArithmeticBenchmark(std::string name, Body body) {
+    return {"ComplexNumber/" + name, [body](BenchmarkState& state) {
+        auto operands = makeOperands();
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto result = body(operands[iteration % operandCount], operands[(iteration + 1) % operandCount]);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }};
+}
+
+void addComplexNumberBenchmarks(std::vector<Benchmark>& benchmarks) {
+    benchmarks.push_back(makeArithmeticBenchmark("add", [](ComplexNumber first, ComplexNumber second) { return first + second; }));
+    benchmarks.push_back(makeArithmeticBenchmark("subtract", [](ComplexNumber first, ComplexNumber second) { return first - second; }));
+    benchmarks.push_back(makeArithmeticBenchmark("multiply", [](ComplexNumber first, ComplexNumber second) { return first * second; }));
+    benchmarks.push_back(makeArithmeticBenchmark("divide", [](ComplexNumber first, ComplexNumber second) { return first / second; }));
+    benchmarks.push_back(makeArithmeticBenchmark("multiplyDouble", [](ComplexNumber first, ComplexNumber) { return first * 1.5; }));
+    benchmarks.push_back(makeArithmeticBenchmark("divideDouble", [](ComplexNumber first, ComplexNumber) { return first / 1.5; }));
+    benchmarks.push_back(makeArithmeticBenchmark("modulus", [](ComplexNumber first, ComplexNumber) { return first.modulus(); }));
+    benchmarks.push_back(makeArithmeticBenchmark("argument", [](ComplexNumber first, ComplexNumber) { return first.argument(); }));
+    benchmarks.push_back(makeArithmeticBenchmark("to_string", [](ComplexNumber first, ComplexNumber) { return first.to_string(); }));
+
+    benchmarks.push_back({"ComplexNumber/to_chars", [](BenchmarkState& state) {
+        auto operands = makeOperands();
+        char buffer[complexNumberCharsLength];
+        size_t bytes = 0;
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto result = operands[iteration % operandCount].to_chars(buffer, buffer + complexNumberCharsLength);
+            bytes += result.ptr - buffer;
+            doNotOptimize(buffer);
+        }
+        state.setItemsProcessed(state.iterationCount());
+        state.setBytesProcessed(bytes);
+    }});
+}
+
+// MARK: - Precision
+
+// Largest relative error of Scalar against long double over the operand set,
+// for products, quotients, moduli and arguments of neighbouring operands.
+template <typename Scalar>
+double maximalRelativeError(const std::vector<ComplexNumber>& operands) {
+    double maximal = 0;
+    auto record = [&maximal](BasicComplexNumber<Scalar> value, ComplexNumberLongDouble reference) {
+        auto difference = ComplexNumberLongDouble(value.getReal(), value.getImaginary()) - reference;
+        auto magnitude = reference.modulus();
+        if (magnitude > 0) {
+            maximal = std::max(maximal, static_cast<double>(difference.modulus() / magnitude));
+        }
+    };
+
+    for (size_t index = 0; index < operands.size(); ++index) {
+        const auto& first = operands[index];
+        const auto& second = operands[(index + 1) % operands.size()];
+        BasicComplexNumber<Scalar> x (Scalar(first.getReal()), Scalar(first.getImaginary()));
+        BasicComplexNumber<Scalar> y (Scalar(second.getReal()), Scalar(second.getImaginary()));
+        ComplexNumberLongDouble xReference (first.getReal(), first.getImaginary());
+        ComplexNumberLongDouble yReference (second.getReal(), second.getImaginary());
+
+        record(x * y, xReference * yReference);
+        record(x / y, xReference / yReference);
+        record(x.modulus(), xReference.modulus());
+        record(x.argument(), xReference.argument());
+    }
+    return maximal;
+}
+
+template <typename Scalar>
+void addPrecisionBenchmarks(std::vector<Benchmark>& benchmarks, std::string tier) {
+    benchmarks.push_back({"Precision/" + tier + "/multiplyAdd", [](BenchmarkState& state) {
+        const size_t size = 1 << 14;
+        std::vector<BasicComplexNumber<Scalar>> values (size, BasicComplexNumber<Scalar>(1, 0));
+        std::vector<BasicComplexNumber<Scalar>> factors;
+        for (size_t index = 0; index < size; ++index) {
+            factors.push_back(BasicComplexNumber<Scalar>(Scalar(0.5) + Scalar(index % 3) * Scalar(0.25), Scalar(index % 5) * Scalar(0.125)));
+        }
+        const BasicComplexNumber<Scalar> offset (Scalar(0.25), Scalar(-0.5));
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            for (size_t index = 0; index < size; ++index) {
+                values[index] = values[index] * factors[index] + offset;
+            }
+            doNotOptimize(values);
+        }
+        state.setItemsProcessed(state.iterationCount() * size);
+        state.setBytesProcessed(state.iterationCount() * size * 2 * sizeof(BasicComplexNumber<Scalar>));
+        state.setCounter("max_relative_error", maximalRelativeError<Scalar>(makeOperands()));
+    }});
+
+    const std::vector<std::string> lines = {"2.5+i3.75 * 4.125", "1-i2 modulus", "2+i3 + 1-i1", "12.5-i0.75 / 3", "-i4 arg"};
+    benchmarks.push_back({"Precision/" + tier + "/BatchEvaluator", [lines](BenchmarkState& state) {
+        BasicBatchEvaluator<Scalar> evaluator (0);
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            auto result = evaluator.evaluate(lines[iteration % lines.size()]);
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount());
+    }});
+}
+
+// MARK: - Complex Array
+
+void addComplexArrayBenchmarks(std::vector<Benchmark>& benchmarks) {
+    const size_t size = 1 << 16;
+
+    for (auto level: {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (level > supportedSimdLevel()) {
+            continue;
+        }
+        auto suffix = "/" + simdLevelName(level);
+
+        benchmarks.push_back({"ComplexArray/add" + suffix, [level, size](BenchmarkState& state) {
+            auto first = makeComplexArray(size);
+            auto second = makeComplexArray(size);
+            ComplexArray result (size);
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                ComplexArray::add(first, second, result, level);
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount() * size);
+            state.setBytesProcessed(state.iterationCount() * size * 4 * sizeof(double));
+        }});
+
+        benchmarks.push_back({"ComplexArray/modulus" + suffix, [level, size](BenchmarkState& state) {
+            auto operand = makeComplexArray(size);
+            AlignedBuffer result (size);
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                ComplexArray::modulus(operand, result, level);
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount() * size);
+            state.setBytesProcessed(state.iterationCount() * size * 2 * sizeof(double));
+        }});
+
+        for (auto accuracy: {ArgumentAccuracy::FULL, ArgumentAccuracy::FAST, ArgumentAccuracy::COARSE}) {
+            benchmarks.push_back({"ComplexArray/argument/" + accuracyName(accuracy) + suffix, [level, size, accuracy](BenchmarkState& state) {
+                auto operand = makeComplexArray(size);
+                AlignedBuffer result (size);
+                for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                    ComplexArray::argument(operand, result, accuracy, level);
+                    doNotOptimize(result);
+                }
+                state.setItemsProcessed(state.iterationCount() * size);
+                state.setBytesProcessed(state.iterationCount() * size * 2 * sizeof(double));
+            }});
+        }
+    }
+}
+
+// MARK: - Polar Functions
+
+// Batch modulus and argument over a plain ComplexNumber array, spanning
+// every quadrant, with the largest error against std::hypot / std::atan2.
+void addPolarBenchmarks(std::vector<Benchmark>& benchmarks) {
+    const size_t size = 1 << 16;
+    std::vector<ComplexNumber> numbers;
+    for (size_t index = 0; index < size; ++index) {
+        double angle = index * 6.283185307179586 / size;
+        numbers.push_back(ComplexNumber(std::cos(angle) * (index + 1), std::sin(angle) * (index + 1)));
+    }
+
+    benchmarks.push_back({"Polar/modulus/member", [numbers](BenchmarkState& state) {
+        std::vector<double> result (numbers.size());
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            for (size_t index = 0; index < numbers.size(); ++index) {
+                result[index] = numbers[index].modulus();
+            }
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount() * numbers.size());
+    }});
+
+    benchmarks.push_back({"Polar/argument/member", [numbers](BenchmarkState& state) {
+        std::vector<double> result (numbers.size());
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            for (size_t index = 0; index < numbers.size(); ++index) {
+                result[index] = numbers[index].argument();
+            }
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount() * numbers.size());
+    }});
+
+    for (auto level: {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (level > supportedSimdLevel()) {
+            continue;
+        }
+        auto suffix = "/" + simdLevelName(level);
+
+        benchmarks.push_back({"Polar/modulus" + suffix, [numbers, level](BenchmarkState& state) {
+            std::vector<double> result (numbers.size());
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                modulus(numbers.data(), result.data(), numbers.size(), level);
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount() * numbers.size());
+        }});
+
+        for (auto accuracy: {ArgumentAccuracy::FULL, ArgumentAccuracy::FAST, ArgumentAccuracy::COARSE}) {
+            benchmarks.push_back({"Polar/argument/" + accuracyName(accuracy) + suffix, [numbers, level, accuracy](BenchmarkState& state) {
+                std::vector<double> result (numbers.size());
+                for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                    argument(numbers.data(), result.data(), numbers.size(), accuracy, level);
+                    doNotOptimize(result);
+                }
+                state.setItemsProcessed(state.iterationCount() * numbers.size());
+
+                double maximal = 0;
+                for (size_t index = 0; index < numbers.size(); ++index) {
+                    maximal = std::max(maximal, std::fabs(result[index] - std::atan2(numbers[index].getImaginary(), numbers[index].getReal())));
+                }
+                state.setCounter("max_absolute_error", maximal);
+            }});
+        }
+    }
+}
+
+// MARK: - Polar Chains
+
+// Every step multiplies, divides and raises to the next of these; their
+// product is 1, so magnitudes stay bounded on long chains.
+const double chainExponents[] = {2, 0.5, -3, -1.0/3};
+
+// The best a cartesian-only engine can do: squaring for integers and a
+// round trip through polar for anything else.
+ComplexNumber eagerPower(ComplexNumber base, double exponent) {
+    if (std::trunc(exponent) == exponent) {
+        return integerPower(base, static_cast<long>(exponent));
+    }
+    return PolarNumber(base).power(exponent).toCartesian();
+}
+
+ComplexNumber eagerChain(ComplexNumber value, const std::vector<ComplexNumber>& factors, size_t length) {
+    for (size_t step = 0; step < length; ++step) {
+        value = value * factors[step % factors.size()] / factors[(step + 1) % factors.size()];
+        value = eagerPower(value, chainExponents[step % 4]);
+    }
+    return value;
+}
+
+// Factors held in both forms, as compiled expressions keep their constants.
+ComplexNumber lazyChain(ComplexNumber start, const std::vector<LazyComplexNumber>& factors, size_t length) {
+    LazyComplexNumber value (start);
+    for (size_t step = 0; step < length; ++step) {
+        value = value * factors[step % factors.size()] / factors[(step + 1) % factors.size()];
+        value = value.power(ComplexNumber(chainExponents[step % 4]));
+    }
+    return value.cartesianForm();
+}
+
+// Chains of *, / and powers on numbers near the unit circle, eager against
+// lazy, with the largest relative difference between the two.
+void addPolarChainBenchmarks(std::vector<Benchmark>& benchmarks) {
+    std::vector<ComplexNumber> factors;
+    for (size_t index = 0; index < 64; ++index) {
+        double angle = index * 0.7;
+        double radius = 1 + (index % 5) * 0.01;
+        factors.push_back(ComplexNumber(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+    std::vector<LazyComplexNumber> lazyFactors;
+    for (const auto& factor: factors) {
+        lazyFactors.push_back(factor);
+        lazyFactors.back().polarForm();
+    }
+
+    for (size_t length: {4, 16, 64}) {
+        auto suffix = "/length:" + std::to_string(length);
+
+        benchmarks.push_back({"PolarChain/eager" + suffix, [factors, length](BenchmarkState& state) {
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto result = eagerChain(factors[iteration % factors.size()], factors, length);
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount() * length);
+        }});
+
+        benchmarks.push_back({"PolarChain/lazy" + suffix, [factors, lazyFactors, length](BenchmarkState& state) {
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto result = lazyChain(factors[iteration % factors.size()], lazyFactors, length);
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount() * length);
+
+            double maximal = 0;
+            for (const auto& start: factors) {
+                auto eager = eagerChain(start, factors, length);
+                maximal = std::max(maximal, (lazyChain(start, lazyFactors, length) - eager).modulus() / eager.modulus());
+            }
+            state.setCounter("max_relative_difference", maximal);
+        }});
+    }
+}
+
+// MARK: - Column Reader
+
+std::string makeColumnText(size_t lineCount) {
+    std::string text;
+    for (size_t index = 0; index < lineCount; ++index) {
+        text += std::to_string(index * 0.37 - 1000.0) + "," + std::to_string(250.0 - index * 0.013) + "\n";
+    }
+    return text;
+}
+
+// The whole text per SIMD level and thread count, against reading it line
+// by line with stream extraction.
+void addColumnReaderBenchmarks(std::vector<Benchmark>& benchmarks) {
+    const size_t lineCount = 1 << 16;
+    const auto text = makeColumnText(lineCount);
+
+    benchmarks.push_back({"ColumnReader/baseline/stream", [text, lineCount](BenchmarkState& state) {
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            std::istringstream stream (text);
+            ComplexArray result (lineCount);
+            std::string line;
+            size_t index = 0;
+            while (std::getline(stream, line)) {
+                std::replace(line.begin(), line.end(), ',', ' ');
+                std::istringstream fields (line);
+                double real = 0, imaginary = 0;
+                fields >> real >> imaginary;
+                result.set(index++, ComplexNumber(real, imaginary));
+            }
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount() * lineCount);
+        state.setBytesProcessed(state.iterationCount() * text.size());
+    }});
+
+    const size_t hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    for (auto level: {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (level > supportedSimdLevel()) {
+            continue;
+        }
+        for (size_t threadCount: {size_t(1), hardwareThreads}) {
+            auto name = "ColumnReader/read/" + simdLevelName(level) + "/threads:" + std::to_string(threadCount);
+            benchmarks.push_back({name, [text, lineCount, level, threadCount](BenchmarkState& state) {
+                ColumnReader reader (threadCount, level);
+                for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                    auto result = reader.read(text);
+                    doNotOptimize(result);
+                }
+                state.setItemsProcessed(state.iterationCount() * lineCount);
+                state.setBytesProcessed(state.iterationCount() * text.size());
+            }});
+            if (hardwareThreads == 1) {
+                break;
+            }
+        }
+    }
+}
+
+// MARK: - Complex Stream
+
+// Exchanging numbers as text, written with to_chars and read back through
+// the tokenizer and flows as batch input is, against a complex stream.
+// The parts stay well away from zero: operands have no exponent notation,
+// so text can't carry tiny values back at all.
+void addComplexStreamBenchmarks(std::vector<Benchmark>& benchmarks) {
+    const size_t count = 1 << 16;
+    std::vector<ComplexNumber> numbers;
+    ComplexArray array (count);
+    for (size_t index = 0; index < count; ++index) {
+        numbers.emplace_back(1000 + std::sin(index * 0.37) * 900, -2 - std::cos(index * 0.013));
+        array.set(index, numbers.back());
+    }
+
+    std::string text;
+    for (const auto& number: numbers) {
+        text += number.to_string() + "\n";
+    }
+    std::string interleaved;
+    appendComplexStreamHeader(interleaved, ComplexLayout::INTERLEAVED, count);
+    for (const auto& number: numbers) {
+        appendComplexRecord(interleaved, number);
+    }
+    std::ostringstream planarStream;
+    writeComplexStream(planarStream, array, ComplexLayout::PLANAR);
+    const std::string planar = planarStream.str();
+
+    benchmarks.push_back({"ComplexStream/write/text", [numbers, text](BenchmarkState& state) {
+        std::string output;
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            output.clear();
+            for (const auto& number: numbers) {
+                auto size = output.size();
+                output.resize(size + complexNumberCharsLength);
+                auto end = number.to_chars(&output[size], &output[size] + complexNumberCharsLength).ptr;
+                output.resize(end - output.data());
+                output += '\n';
+            }
+            doNotOptimize(output);
+        }
+        state.setItemsProcessed(state.iterationCount() * numbers.size());
+        state.setBytesProcessed(state.iterationCount() * text.size());
+    }});
+
+    benchmarks.push_back({"ComplexStream/write/binary", [numbers, interleaved](BenchmarkState& state) {
+        std::string output;
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            output.clear();
+            appendComplexStreamHeader(output, ComplexLayout::INTERLEAVED, numbers.size());
+            for (const auto& number: numbers) {
+                appendComplexRecord(output, number);
+            }
+            doNotOptimize(output);
+        }
+        state.setItemsProcessed(state.iterationCount() * numbers.size());
+        state.setBytesProcessed(state.iterationCount() * interleaved.size());
+    }});
+
+    benchmarks.push_back({"ComplexStream/read/text", [text, count](BenchmarkState& state) {
+        Tokenizer tokenizer;
+        FlowProcessor processor;
+        RequestArena arena;
+        for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+            ComplexArray result (count);
+            std::string_view rest (text);
+            for (size_t index = 0; !rest.empty(); ++index) {
+                auto end = rest.find('\n');
+                arena.reset();
+                auto tokens = tokenizer.tokenize(rest.substr(0, end), arena.resource());
+                auto number = processor.process(Flow<ComplexOperand>(tokens));
+                result.set(index, number.success());
+                rest.remove_prefix(end + 1);
+            }
+            doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterationCount() * count);
+        state.setBytesProcessed(state.iterationCount() * text.size());
+    }});
+
+    for (const auto& [layout, bytes]: {std::make_pair(std::string("interleaved"), interleaved), std::make_pair(std::string("planar"), planar)}) {
+        benchmarks.push_back({"ComplexStream/read/binary/" + layout, [bytes = bytes, count](BenchmarkState& state) {
+            for (size_t iteration = 0; iteration < state.iterationCount(); ++iteration) {
+                auto result = ComplexStreamView::parse(bytes).success().toArray();
+                doNotOptimize(result);
+            }
+            state.setItemsProcessed(state.iterationCount() * count);
+            state.setBytesProcessed(state.iterationCount() * bytes.size());
+        }});
+    }
+}
+
+// MARK: - Entry Point
+
+int main(int argc, char* argv[]) {
+    observeAllocations([](size_t) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    });
+    allocationsCounted = true;
+    std::vector<Benchmark> benchmarks;
+
+    addTokenizerBenchmarks(benchmarks);
+    addFlowProcessorBenchmarks(benchmarks);
+    addExpressionBenchmarks(benchmarks);
+    addExpressionCacheBenchmarks(benchmarks);
+    addPipelineBenchmarks(benchmarks);
+    addCalculatorBenchmarks(benchmarks);
+    addComplexNumberBenchmarks(benchmarks);
+    addPolarChainBenchmarks(benchmarks);
+    addPrecisionBenchmarks<float>(benchmarks, "float");
+    addPrecisionBenchmarks<double>(benchmarks, "double");
+    addPrecisionBenchmarks<long double>(benchmarks, "long_double");
+    addComplexArrayBenchmarks(benchmarks);
+    addPolarBenchmarks(benchmarks);
+    addColumnReaderBenchmarks(benchmarks);
+    addComplexStreamBenchmarks(benchmarks);
+
+    return runBenchmarks(benchmarks, argc, argv);
+}
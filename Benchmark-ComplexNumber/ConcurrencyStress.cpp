@@ -0,0 +1,290 @@
+//
+//  ConcurrencyStress.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Hammers the core from many threads at once, the way Batch's workers and
+//  the server use it: one Tokenizer, FlowProcessor, ExpressionCompiler and
+//  set of compiled programs shared by every thread, and an evaluator, arena
+//  and stack per thread. Every result is compared with one computed up
+//  front on a single thread. Meant to run under ThreadSanitizer, which
+//  reports any unsynchronised access the comparison can't see:
+//    cmake -S .. -B tsan -DCMAKE_BUILD_TYPE=RelWithDebInfo
+//        -DCMAKE_CXX_FLAGS=-fsanitize=thread
+//    cmake --build tsan --target stress
+//  Add -DCOMPLEX_NUMBER_INSTRUMENTATION=ON to check the metrics shards too.
+//  ctest runs it briefly in any build.
+//  Run: ./stress [--threads=8] [--rounds=20]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Source-ComplexNumber/Batch.hpp"
+#include "../Source-ComplexNumber/ComplexArray.hpp"
+#include "../Source-ComplexNumber/Expression.hpp"
+#include "../Source-ComplexNumber/Flow.hpp"
+#include "../Source-ComplexNumber/FlowProcessor.hpp"
+#include "../Source-ComplexNumber/RequestArena.hpp"
+#include "../Source-ComplexNumber/ThreadPool.hpp"
+#include "../Source-ComplexNumber/Tokenizer.hpp"
+
+// MARK: - Inputs
+
+const std::vector<std::string> operands = {
+    "2+i3", "-i2 -2.222", "2.222", "-i1.2", "1e308+i1e308", "0", "i", "-i", "3.5e-7-i8",
+    "2+", "i2 i3", "abc", "", "+-2", "1.2.3", "(1+i)"
+};
+
+const std::vector<std::string> expressions = {
+    "(2+i3)*(1-i)/4 + modulus(3+i4)",
+    "(1+i) power 5",
+    "-(1+i) power 2",
+    "exp(i3.14159) * log(2-i)",
+    "((1+i) * (2-i3) / (4+i)) root 3",
+    "arg(-1) - arg(i)",
+    "1/0"
+};
+
+std::string makeLines(BatchMode mode, size_t count) {
+    std::string text;
+    for (size_t index = 0; index < count; ++index) {
+        auto real = std::to_string(static_cast<double>(index % 997) / 8);
+        auto imaginary = std::to_string(static_cast<double>(index * 31 % 1009) / 16);
+        if (mode == BatchMode::OPERATION) {
+            const char* operations[] = {" + ", " - ", " * ", " / ", " modulus", " arg", " power 3", " root 2", " exp", " log", " ? "};
+            text += real + "+i" + imaginary + operations[index % 11];
+            if (index % 11 < 4 || index % 11 == 10) {
+                text += index % 11 < 2 ? "1-i" + real : imaginary;
+            }
+        } else {
+            text += "(" + real + "+i" + imaginary + ") * (1-i2) / 4 + modulus(3+i4) power " + std::to_string(index % 4);
+            if (index % 13 == 0) {
+                text += " +";
+            }
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+// A value or an error, written out so results compare as strings.
+template <typename Value>
+std::string describe(const Result<Value>& result) {
+    std::ostringstream output;
+    output.precision(17);
+    if (result.hasError()) {
+        output << "error " << result.error().description << " " << result.error().position.value_or(-1);
+    } else if constexpr (std::is_same<Value, ComplexNumber>::value) {
+        output << result.success().getReal() << " " << result.success().getImaginary();
+    } else {
+        output << result.success();
+    }
+    return output.str();
+}
+
+// Equal, with NaN matching NaN.
+bool isSameNumber(const ComplexNumber& lhs, const ComplexNumber& rhs) {
+    auto isSame = [](double lhs, double rhs) { return lhs == rhs || (lhs != lhs && rhs != rhs); };
+    return isSame(lhs.getReal(), rhs.getReal()) && isSame(lhs.getImaginary(), rhs.getImaginary());
+}
+
+// MARK: - Checks
+
+struct Shared {
+    Tokenizer tokenizer;
+    FlowProcessor processor;
+    ExpressionCompiler compiler;
+    std::vector<CompiledExpression> programs;
+    std::vector<ComplexNumber> numbers;
+    std::string operationLines;
+    std::string expressionLines;
+};
+
+struct Expected {
+    std::vector<std::string> operands;
+    std::vector<std::string> doubles;
+    std::vector<ComplexNumber> programs;
+    std::vector<double> moduli;
+    std::string operationAnswers;
+    std::string expressionAnswers;
+};
+
+// One round of everything, with this thread's own scratch; returns the
+// number of results that differ from expected.
+size_t runRound(const Shared& shared, const Expected& expected) {
+    size_t mismatches = 0;
+
+    RequestArena arena;
+    for (size_t index = 0; index < operands.size(); ++index) {
+        arena.reset();
+        auto tokens = shared.tokenizer.tokenize(operands[index], arena.resource());
+        mismatches += describe(shared.processor.process(Flow<ComplexOperand>(tokens))) != expected.operands[index];
+        mismatches += describe(shared.processor.process(Flow<DoubleOperand>(tokens))) != expected.doubles[index];
+    }
+
+    // The shared programs, and the same programs compiled again here.
+    std::vector<BasicLazyComplexNumber<double>> stack;
+    for (size_t index = 0; index < shared.programs.size(); ++index) {
+        auto compiled = shared.compiler.compile(expressions[index]);
+        mismatches += compiled.hasError();
+        for (const auto* program: {&shared.programs[index], compiled.hasError() ? &shared.programs[index] : &compiled.success()}) {
+            auto value = program->evaluate(stack);
+            mismatches += !isSameNumber(value, expected.programs[index]);
+        }
+    }
+
+    std::vector<double> moduli (shared.numbers.size());
+    modulus(shared.numbers.data(), moduli.data(), shared.numbers.size());
+    mismatches += moduli != expected.moduli;
+
+    // A small cache, so entries are evicted and replaced while it runs.
+    BatchEvaluator batchEvaluator (64);
+    std::string answers;
+    evaluateLines(shared.operationLines, batchEvaluator, answers);
+    mismatches += answers != expected.operationAnswers;
+
+    ExpressionEvaluator expressionEvaluator (64);
+    answers.clear();
+    evaluateLines(shared.expressionLines, expressionEvaluator, answers);
+    mismatches += answers != expected.expressionAnswers;
+
+    return mismatches;
+}
+
+// MARK: - Entry Point
+
+int main(int argc, char* argv[]) {
+    size_t threadCount = 8;
+    size_t roundCount = 20;
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        if (argument.rfind("--threads=", 0) == 0) {
+            threadCount = std::max<size_t>(std::stoul(argument.substr(10)), 1);
+        } else if (argument.rfind("--rounds=", 0) == 0) {
+            roundCount = std::stoul(argument.substr(9));
+        } else {
+            std::cerr << "Unknown argument " << argument << std::endl;
+            return 1;
+        }
+    }
+
+    Shared shared;
+    for (const auto& expression: expressions) {
+        auto program = shared.compiler.compile(expression);
+        if (program.hasError()) {
+            std::cerr << "Can't compile " << expression << ": " << program.error().description << std::endl;
+            return 1;
+        }
+        shared.programs.push_back(std::move(program).success());
+    }
+    for (size_t index = 0; index < 1000; ++index) {
+        shared.numbers.emplace_back(static_cast<double>(index) / 3 - 100, static_cast<double>(index % 17) - 8);
+    }
+    shared.operationLines = makeLines(BatchMode::OPERATION, 2000);
+    shared.expressionLines = makeLines(BatchMode::EXPRESSION, 2000);
+
+    Expected expected;
+    for (const auto& operand: operands) {
+        auto tokens = shared.tokenizer.tokenize(operand);
+        expected.operands.push_back(describe(shared.processor.process(Flow<ComplexOperand>(tokens))));
+        expected.doubles.push_back(describe(shared.processor.process(Flow<DoubleOperand>(tokens))));
+    }
+    for (const auto& program: shared.programs) {
+        expected.programs.push_back(program.evaluate());
+    }
+    expected.moduli.resize(shared.numbers.size());
+    modulus(shared.numbers.data(), expected.moduli.data(), shared.numbers.size());
+    BatchEvaluator batchEvaluator;
+    evaluateLines(shared.operationLines, batchEvaluator, expected.operationAnswers);
+    ExpressionEvaluator expressionEvaluator;
+    evaluateLines(shared.expressionLines, expressionEvaluator, expected.expressionAnswers);
+
+    // Threads spin until all have started, so the rounds overlap.
+    std::atomic<size_t> ready {0};
+    std::atomic<size_t> mismatches {0};
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < threadCount; ++thread) {
+        threads.emplace_back([&]() {
+            ready.fetch_add(1);
+            while (ready.load() < threadCount) {
+                std::this_thread::yield();
+            }
+            for (size_t round = 0; round < roundCount; ++round) {
+                mismatches.fetch_add(runRound(shared, expected));
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    // Batch's own workers over one shared input, several runs at once.
+    std::string reference;
+    {
+        Batch batch (BatchMode::EXPRESSION);
+        batch.threadCount = 1;
+        std::ostringstream output;
+        batch.run(std::string_view(shared.expressionLines), output);
+        reference = output.str();
+    }
+    std::vector<std::thread> batches;
+    for (size_t thread = 0; thread < std::min<size_t>(threadCount, 4); ++thread) {
+        batches.emplace_back([&]() {
+            Batch batch (BatchMode::EXPRESSION, 64);
+            batch.threadCount = threadCount;
+            std::ostringstream output;
+            batch.run(std::string_view(shared.expressionLines), output);
+            mismatches.fetch_add(output.str() != reference);
+        });
+    }
+    for (auto& thread: batches) {
+        thread.join();
+    }
+
+    // Parsed jobs spread over a pool each, against calculating them in turn.
+    // Compared as the text line Batch would print.
+    auto jobAnswer = [](Result<BatchValue> result) {
+        std::string answer;
+        appendResult(answer, result);
+        return answer;
+    };
+    std::vector<CalculationJob> jobs;
+    std::vector<std::string> expectedJobs;
+    {
+        BatchEvaluator parser (0);
+        std::istringstream lines (shared.operationLines);
+        std::string line;
+        while (std::getline(lines, line)) {
+            auto job = parser.parse(line);
+            if (job.hasSuccess()) {
+                jobs.push_back(job.success());
+                expectedJobs.push_back(jobAnswer(calculate(jobs.back())));
+            }
+        }
+    }
+    std::vector<std::thread> evaluations;
+    for (size_t thread = 0; thread < std::min<size_t>(threadCount, 4); ++thread) {
+        evaluations.emplace_back([&]() {
+            ThreadPool pool (threadCount);
+            for (size_t grain: {0, 1, 64}) {
+                auto results = evaluate(jobs, pool, grain);
+                for (size_t index = 0; index < jobs.size(); ++index) {
+                    mismatches.fetch_add(jobAnswer(results[index]) != expectedJobs[index]);
+                }
+            }
+        });
+    }
+    for (auto& thread: evaluations) {
+        thread.join();
+    }
+
+    std::cout << threadCount << " threads, " << roundCount << " rounds: " << mismatches.load() << " mismatches" << std::endl;
+    return mismatches.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+//
+//  DispatchBenchmark.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Cost of dispatching a binary operation: the std::function wrappers
+//  FlowProcessor used to return against the enum switch and the templated
+//  kernels of Calculator.
+//  Build: cmake --build <build directory> --target dispatch
+//
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "../Source-ComplexNumber/Calculator.hpp"
+
+typedef std::function<ComplexNumber(ComplexNumber, ComplexNumber)> LegacyBinaryComplexOperation;
+
+template <typename Body>
+double nanosecondsPerOperation(size_t operations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / operations;
+}
+
+int main() {
+    const size_t count = 1 << 20;
+    const int rounds = 20;
+
+    std::vector<ComplexNumber> operands;
+    for (size_t index = 0; index < count; ++index) {
+        operands.push_back(ComplexNumber(index * 0.5, 1.0 - index * 0.25));
+    }
+    ComplexNumber sum (0, 0);
+
+    LegacyBinaryComplexOperation legacy = [](ComplexNumber first, ComplexNumber second) { return first + second; };
+    auto legacyTime = nanosecondsPerOperation(count * rounds, [&]() {
+        for (int round = 0; round < rounds; ++round) {
+            for (auto& operand: operands) {
+                sum = legacy(sum, operand);
+            }
+        }
+    });
+
+    volatile auto selected = BinaryComplexOperation::PLUS;
+    auto switchTime = nanosecondsPerOperation(count * rounds, [&]() {
+        for (int round = 0; round < rounds; ++round) {
+            for (auto& operand: operands) {
+                sum = Calculator::calculate(std::make_pair(sum, operand), selected);
+            }
+        }
+    });
+
+    auto templateTime = nanosecondsPerOperation(count * rounds, [&]() {
+        for (int round = 0; round < rounds; ++round) {
+            for (auto& operand: operands) {
+                sum = Calculator::apply<BinaryComplexOperation::PLUS>(sum, operand);
+            }
+        }
+    });
+
+    std::cout << "std::function\t" << legacyTime << " ns/op\n";
+    std::cout << "enum switch\t" << switchTime << " ns/op\n";
+    std::cout << "template\t" << templateTime << " ns/op\n";
+    std::cerr << "checksum " << sum.getReal() << "\n";
+    return 0;
+}
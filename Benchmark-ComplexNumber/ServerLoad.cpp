@@ -0,0 +1,282 @@
+//
+//  ServerLoad.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Local load generator for --serve. Every client connects, pipelines all
+//  of its lines at once from one thread and reads the answers on another,
+//  and every answer is checked against evaluating the same lines in
+//  process. Then a single client sends one line at a time for round trip
+//  latencies. Without --address a server is started in process on a
+//  temporary Unix socket, or on loopback TCP with --tcp.
+//  Build: cmake --build <build directory> --target server-load
+//  Run:
+//    ./server-load [--address=<path|tcp:port>] [--tcp] [--clients=8]
+//        [--lines=100000] [--round-trips=10000] [--threads=<server workers>]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../Source-ComplexNumber/Batch.hpp"
+#include "../Source-ComplexNumber/Server.hpp"
+
+// MARK: - Requests
+
+// Expressions of every kind the evaluator knows, with a malformed line
+// now and then.
+std::string makeRequests(size_t client, size_t lineCount) {
+    std::string requests;
+    for (size_t index = 0; index < lineCount; ++index) {
+        auto real = std::to_string(static_cast<double>((client * 7919 + index) % 1000) / 8);
+        auto imaginary = std::to_string(static_cast<double>((client * 104729 + index * 31) % 1000) / 16);
+        switch (index % 6) {
+            case 0:
+                requests += "(" + real + "+i" + imaginary + ") * (1-i2) / 4 + modulus(3+i4)\n";
+                break;
+            case 1:
+                requests += real + "-i" + imaginary + " * " + real + "\n";
+                break;
+            case 2:
+                requests += "(" + real + "+i" + imaginary + ") power 3\n";
+                break;
+            case 3:
+                requests += "arg(-" + real + "+i" + imaginary + ") + log(" + imaginary + ")\n";
+                break;
+            case 4:
+                requests += "exp(i" + imaginary + ") / (" + real + " + i)\n";
+                break;
+            default:
+                requests += real + " + + " + imaginary + "\n";
+                break;
+        }
+    }
+    return requests;
+}
+
+std::string expectedAnswers(const std::string& requests) {
+    ExpressionEvaluator evaluator;
+    std::string answers;
+    evaluateLines(requests, evaluator, answers);
+    return answers;
+}
+
+// MARK: - Sockets
+
+int connectTo(const std::string& address) {
+    if (address.rfind("tcp:", 0) == 0) {
+        int descriptor = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in socketAddress {};
+        socketAddress.sin_family = AF_INET;
+        socketAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socketAddress.sin_port = htons(static_cast<unsigned short>(std::stoul(address.substr(4))));
+        if (connect(descriptor, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0) {
+            close(descriptor);
+            return -1;
+        }
+        int enabled = 1;
+        setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        return descriptor;
+    }
+    int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un socketAddress {};
+    socketAddress.sun_family = AF_UNIX;
+    std::strncpy(socketAddress.sun_path, address.c_str(), sizeof(socketAddress.sun_path) - 1);
+    if (connect(descriptor, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0) {
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+}
+
+bool sendAll(int descriptor, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t count = send(descriptor, data, size, MSG_NOSIGNAL);
+        if (count <= 0) {
+            return false;
+        }
+        data += count;
+        size -= count;
+    }
+    return true;
+}
+
+// MARK: - Load
+
+struct ClientResult {
+    size_t answers = 0;
+    size_t bytes = 0;
+    bool isCorrect = false;
+};
+
+// All lines in flight at once: a writer thread sends them and closes its
+// side, the calling thread reads until the server closes.
+ClientResult runPipelinedClient(const std::string& address, const std::string& requests, const std::string& expected) {
+    ClientResult result;
+    int descriptor = connectTo(address);
+    if (descriptor < 0) {
+        return result;
+    }
+
+    std::thread writer([descriptor, &requests]() {
+        sendAll(descriptor, requests.data(), requests.size());
+        shutdown(descriptor, SHUT_WR);
+    });
+
+    std::string answers;
+    answers.reserve(expected.size());
+    char buffer[64 << 10];
+    while (true) {
+        ssize_t count = recv(descriptor, buffer, sizeof(buffer), 0);
+        if (count <= 0) {
+            break;
+        }
+        answers.append(buffer, count);
+    }
+    writer.join();
+    close(descriptor);
+
+    result.answers = std::count(answers.begin(), answers.end(), '\n');
+    result.bytes = requests.size() + answers.size();
+    result.isCorrect = answers == expected;
+    return result;
+}
+
+// One line, then wait for its answer, round after round.
+std::vector<double> measureRoundTrips(const std::string& address, size_t count) {
+    std::vector<double> latencies;
+    int descriptor = connectTo(address);
+    if (descriptor < 0) {
+        return latencies;
+    }
+    const std::string request = "(2+i3) * (1-i2) / 4 + modulus(3+i4)\n";
+    char buffer[4096];
+    for (size_t round = 0; round < count; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        if (!sendAll(descriptor, request.data(), request.size())) {
+            break;
+        }
+        bool isAnswered = false;
+        while (!isAnswered) {
+            ssize_t received = recv(descriptor, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                close(descriptor);
+                return latencies;
+            }
+            isAnswered = std::memchr(buffer, '\n', received) != nullptr;
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    close(descriptor);
+    return latencies;
+}
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// MARK: - Entry Point
+
+int main(int argc, char* argv[]) {
+    std::string address;
+    bool isTCP = false;
+    size_t clientCount = 8;
+    size_t lineCount = 100000;
+    size_t roundTrips = 10000;
+    size_t threadCount = std::thread::hardware_concurrency();
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        if (argument.rfind("--address=", 0) == 0) {
+            address = argument.substr(10);
+        } else if (argument == "--tcp") {
+            isTCP = true;
+        } else if (argument.rfind("--clients=", 0) == 0) {
+            clientCount = std::max<size_t>(std::stoul(argument.substr(10)), 1);
+        } else if (argument.rfind("--lines=", 0) == 0) {
+            lineCount = std::stoul(argument.substr(8));
+        } else if (argument.rfind("--round-trips=", 0) == 0) {
+            roundTrips = std::stoul(argument.substr(14));
+        } else if (argument.rfind("--threads=", 0) == 0) {
+            threadCount = std::max<size_t>(std::stoul(argument.substr(10)), 1);
+        } else {
+            std::cerr << "Unknown argument " << argument << std::endl;
+            return 1;
+        }
+    }
+
+    Server server;
+    std::thread serving;
+    if (address.empty()) {
+        server.threadCount = threadCount;
+        auto bound = server.listen(isTCP ? "tcp:0" : "/tmp/complex-server-load-" + std::to_string(getpid()) + ".sock");
+        if (bound.hasError()) {
+            std::cerr << "Can't serve: " << bound.error().description << std::endl;
+            return 1;
+        }
+        address = bound.success();
+        serving = std::thread([&server]() { server.run(); });
+    }
+
+    std::vector<std::string> requests (clientCount);
+    std::vector<std::string> expected (clientCount);
+    for (size_t client = 0; client < clientCount; ++client) {
+        requests[client] = makeRequests(client, lineCount);
+        expected[client] = expectedAnswers(requests[client]);
+    }
+
+    std::vector<ClientResult> results (clientCount);
+    std::vector<std::thread> clients;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t client = 0; client < clientCount; ++client) {
+        clients.emplace_back([&, client]() {
+            results[client] = runPipelinedClient(address, requests[client], expected[client]);
+        });
+    }
+    for (auto& client: clients) {
+        client.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t answers = 0;
+    size_t bytes = 0;
+    size_t incorrect = 0;
+    for (const auto& result: results) {
+        answers += result.answers;
+        bytes += result.bytes;
+        incorrect += result.isCorrect ? 0 : 1;
+    }
+
+    auto latencies = measureRoundTrips(address, roundTrips);
+
+    std::cout << "address " << address << "\n";
+    std::cout << "pipelined: " << clientCount << " clients, " << answers << " answers in " << seconds << " s, "
+              << answers / seconds << " lines/s, " << bytes / seconds / 1e6 << " MB/s, "
+              << incorrect << " clients with wrong answers\n";
+    std::cout << "round trip: " << latencies.size() << " requests, p50 " << percentile(latencies, 0.5)
+              << " us, p99 " << percentile(latencies, 0.99) << " us\n";
+
+    if (serving.joinable()) {
+        server.stop();
+        serving.join();
+    }
+    return incorrect == 0 && answers == clientCount * lineCount && latencies.size() == roundTrips ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+//
+//  TokenizerBenchmark.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Compares Tokenizer::tokenize with the regex window scanner it replaced.
+//  Build: cmake --build <build directory> --target tokbench
+//
+
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "../Source-ComplexNumber/Tokenizer.hpp"
+
+// MARK: - Regex Tokenizer (reference)
+
+namespace regexTokenizer {
+
+const std::string numberRe = "[-+]?i|[-+]?i?((0|[1-9]\\d*)|(0|[1-9]\\d*)\\.\\d*)";
+
+const std::regex complexRe = std::regex(numberRe, std::regex::icase);
+const std::regex functionRe = std::regex("modulus|arg", std::regex::icase);
+const std::regex operationRe = std::regex("[\\+\\-*\\/]", std::regex::icase);
+const std::regex spaceRe = std::regex(" +", std::regex::icase);
+const std::regex menuRe = std::regex("A|B", std::regex::icase);
+
+// Tokens are views, so they are cut from the input rather than from the
+// temporary string the regexes are matched against.
+std::optional<Token> getNextToken(std::string& input, std::string::iterator& begin, std::string::iterator& end) {
+    std::string expression (begin, end);
+    size_t position = begin - input.begin();
+    std::string_view view = std::string_view(input).substr(position, expression.size());
+
+    if (std::regex_match(expression, spaceRe)) {
+        return std::make_optional(TypedExpression<SpaceExpr> (view, position));
+    } else if (std::regex_match(expression, complexRe)) {
+        return std::make_optional(TypedExpression<ComplexExpr> (view, position));
+    } else if (std::regex_match(expression, functionRe)) {
+        return std::make_optional(TypedExpression<FunctionExpr> (view, position));
+    } else if (std::regex_match(expression, operationRe)) {
+        return std::make_optional(TypedExpression<OperationExpr> (view, position));
+    } else if (std::regex_match(expression, menuRe)) {
+        return std::make_optional(TypedExpression<MenuExpr> (view, position));
+    } else {
+        return std::nullopt;
+    }
+}
+
+std::vector<Token> tokenize(std::string& input) {
+    std::string::iterator bufferBegin = input.begin();
+    std::string::iterator bufferEnd = bufferBegin + 1;
+    std::optional<Token> token = std::nullopt;
+    std::vector<Token> tokens {};
+
+    while (bufferEnd <= input.end()) {
+        auto nextToken = getNextToken(input, bufferBegin, bufferEnd);
+        if (token.has_value() && !nextToken.has_value()) {
+            bufferBegin = bufferEnd - 1;
+            tokens.push_back(token.value());
+        } else {
+            bufferEnd += 1;
+        }
+        token = nextToken;
+    }
+
+    if (!token.has_value()) {
+        size_t position = bufferBegin - input.begin();
+        token = TypedExpression<ErrorExpr>(std::string_view(input).substr(position), position);
+    }
+
+    tokens.push_back(token.value());
+
+    return tokens;
+}
+
+}
+
+// MARK: - Helpers
+
+std::string makeInput(size_t length) {
+    const std::string pattern = "2+i3 * -i4.25 modulus 12.5-i0.75 / B ";
+    std::string input;
+    while (input.size() < length) {
+        input += pattern;
+    }
+    input.resize(length);
+    return input;
+}
+
+bool sameTokens(const std::vector<Token>& lhs, const TokenList& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t index = 0; index < lhs.size(); ++index) {
+        if (lhs[index].index() != rhs[index].index()) {
+            return false;
+        }
+        auto lhsText = std::visit([](const auto& token) { return token.expression; }, lhs[index]);
+        auto rhsText = std::visit([](const auto& token) { return token.expression; }, rhs[index]);
+        if (lhsText != rhsText || tokenPosition(lhs[index]) != tokenPosition(rhs[index])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Body>
+double nanosecondsPerRun(size_t iterations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+        body();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+// MARK: - Entry Point
+
+int main() {
+    Tokenizer tokenizer;
+    size_t checksum = 0;
+
+    std::cout << "length\tregex ns\tdfa ns\tspeedup\n";
+    for (size_t length: {16, 64, 256, 1024}) {
+        auto input = makeInput(length);
+        if (!sameTokens(regexTokenizer::tokenize(input), tokenizer.tokenize(input))) {
+            std::cerr << "token mismatch for length " << length << "\n";
+            return 1;
+        }
+
+        auto iterations = 20000 / length + 1;
+        auto regexTime = nanosecondsPerRun(iterations, [&]() { checksum += regexTokenizer::tokenize(input).size(); });
+        auto dfaTime = nanosecondsPerRun(iterations * 100, [&]() { checksum += tokenizer.tokenize(input).size(); });
+
+        std::cout << length << "\t" << regexTime << "\t" << dfaTime << "\t" << regexTime / dfaTime << "x\n";
+    }
+
+    std::cerr << "checksum " << checksum << "\n";
+    return 0;
+}
@@ -0,0 +1,89 @@
+//
+//  AllocationCounting.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounting.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <malloc.h>
+#define ALLOCATION_NOINLINE __declspec(noinline)
+#else
+#define ALLOCATION_NOINLINE __attribute__((noinline))
+#endif
+
+std::atomic<AllocationObserver> allocationObserver {nullptr};
+
+void observeAllocations(AllocationObserver observer) {
+    allocationObserver.store(observer, std::memory_order_release);
+}
+
+// MARK: - Allocation
+
+// Every operator below goes through these two. They stay out of line so
+// that GCC, which knows what malloc and free are, never sees memory from
+// operator new handed to free, and doesn't warn about a mismatched pair at
+// each call site new and delete are inlined into.
+ALLOCATION_NOINLINE void* allocateCounted(size_t size, size_t alignment) {
+    if (auto observer = allocationObserver.load(std::memory_order_acquire)) {
+        observer(size);
+    }
+    size = size > 0 ? size : 1;
+    void* pointer = nullptr;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        pointer = std::malloc(size);
+    } else {
+#if defined(_MSC_VER) && !defined(__clang__)
+        pointer = _aligned_malloc(size, alignment);
+#else
+        pointer = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+ALLOCATION_NOINLINE void freeCounted(void* pointer, size_t alignment) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return _aligned_free(pointer);
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(pointer);
+}
+
+// MARK: - Replaced Operators
+
+void* operator new(size_t size) {
+    return allocateCounted(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateCounted(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    freeCounted(pointer, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept {
+    freeCounted(pointer, static_cast<size_t>(alignment));
+}
@@ -0,0 +1,27 @@
+//
+//  AllocationCounting.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef AllocationCounting_hpp
+#define AllocationCounting_hpp
+
+#include <cstddef>
+
+// AllocationCounting.cpp replaces the global operator new and delete so
+// that a program can count its allocations: the benchmark suite for
+// allocations_per_iteration, and the calculator built with
+// -DCOMPLEX_NUMBER_INSTRUMENTATION for its ALLOCATIONS and
+// ALLOCATED_BYTES counters. Every allocation through operator new is
+// reported to the observer with its size before it reaches malloc. Until
+// a program sets one nothing is counted, and an allocation costs one
+// extra branch.
+typedef void (*AllocationObserver)(size_t size);
+
+// Safe from any thread. The observer runs inside operator new, so it must
+// not allocate itself.
+void observeAllocations(AllocationObserver observer);
+
+#endif /* AllocationCounting_hpp */
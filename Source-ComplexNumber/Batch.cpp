@@ -0,0 +1,439 @@
+//
+//  Batch.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+#include "Batch.hpp"
+#include "Calculator.hpp"
+#include "ComplexStream.hpp"
+#include "Instrumentation.hpp"
+#include "Pipeline.hpp"
+#include "ThreadPool.hpp"
+
+// MARK: - Evaluation
+
+bool isOperationToken(const Token& token) {
+    return std::holds_alternative<TypedExpression<OperationExpr>>(token) || std::holds_alternative<TypedExpression<FunctionExpr>>(token);
+}
+
+template <typename Scalar>
+Result<BasicBatchValue<Scalar>> calculate(const BasicCalculationJob<Scalar>& job) {
+    typedef BasicBatchValue<Scalar> Value;
+    auto first = job.firstOperand;
+    auto operation = job.operation;
+
+    if (std::holds_alternative<Function>(operation)) {
+        auto function = std::get<Function>(operation);
+        if (isRealValued(function)) {
+            return Result<Value>(Value(Calculator::calculate(first, function)));
+        }
+        auto operands = std::make_pair(first, std::get<Scalar>(job.secondOperand));
+        return Result<Value>(Value(Calculator::calculate(operands, function)));
+    } else if (std::holds_alternative<BinaryComplexOperation>(operation) && std::holds_alternative<BasicComplexNumber<Scalar>>(job.secondOperand)) {
+        auto operands = std::make_pair(first, std::get<BasicComplexNumber<Scalar>>(job.secondOperand));
+        return Result<Value>(Value(Calculator::calculate(operands, std::get<BinaryComplexOperation>(operation))));
+    } else if (std::holds_alternative<BinaryComplexDoubleOperation>(operation) && std::holds_alternative<Scalar>(job.secondOperand)) {
+        auto operands = std::make_pair(first, std::get<Scalar>(job.secondOperand));
+        return Result<Value>(Value(Calculator::calculate(operands, std::get<BinaryComplexDoubleOperation>(operation))));
+    } else {
+        return Result<Value>(Error("operand does not match operation"));
+    }
+}
+
+template <typename Scalar>
+std::vector<Result<BasicBatchValue<Scalar>>> evaluate(const std::vector<BasicCalculationJob<Scalar>>& jobs, ThreadPool& pool, size_t grain) {
+    typedef BasicBatchValue<Scalar> Value;
+    std::vector<Result<Value>> results (jobs.size(), Result<Value>(Value(Scalar(0))));
+
+    pool.parallelFor(jobs.size(), grain, [&jobs, &results](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+            results[index] = calculate(jobs[index]);
+        }
+    });
+
+    return results;
+}
+
+template <typename Scalar>
+Result<BasicCalculationJob<Scalar>> BasicBatchEvaluator<Scalar>::parse(std::string_view line) {
+    arena.reset();
+    return parse(tokenizer.tokenize(line, arena.resource()));
+}
+
+template <typename Scalar>
+Result<BasicCalculationJob<Scalar>> BasicBatchEvaluator<Scalar>::parse(const TokenList& tokens) {
+    auto operationToken = std::find_if(tokens.begin(), tokens.end(), isOperationToken);
+
+    if (operationToken == tokens.end()) {
+        return Result<BasicCalculationJob<Scalar>>(Error("missing operation"));
+    }
+
+    firstOperand.assign(tokens.begin(), operationToken);
+    operation.assign(operationToken, operationToken + 1);
+    secondOperand.assign(operationToken + 1, tokens.end());
+
+    return processor.process(Flow<ComplexOperand>(firstOperand)).and_then([this](BasicComplexNumber<Scalar>&& first) {
+        return processor.process(Flow<Operation>(operation)).and_then([this, &first](OperationType&& operationType) {
+            return parseSecondOperand(first, operationType);
+        });
+    });
+}
+
+template <typename Scalar>
+Result<BasicCalculationJob<Scalar>> BasicBatchEvaluator<Scalar>::parseSecondOperand(BasicComplexNumber<Scalar>& first, OperationType& operationType) {
+    typedef BasicCalculationJob<Scalar> Job;
+
+    auto operand = std::find_if(secondOperand.begin(), secondOperand.end(), [](const Token& token) {
+        return !std::holds_alternative<TypedExpression<SpaceExpr>>(token);
+    });
+    bool isUnaryFunction = std::holds_alternative<Function>(operationType) && !takesExponent(std::get<Function>(operationType));
+    if (operand == secondOperand.end() && !isUnaryFunction) {
+        // Reported here, at the end of the line: the flows would only see
+        // no tokens and call the whole line empty.
+        const Token& last = secondOperand.empty() ? operation.back() : secondOperand.back();
+        return Result<Job>(Error("missing operand", tokenEndPosition(last)));
+    }
+
+    if (std::holds_alternative<Function>(operationType) && takesExponent(std::get<Function>(operationType))) {
+        return processor.process(Flow<DoubleOperand>(secondOperand)).transform([&first, &operationType](Scalar&& exponent) {
+            return Job(first, operationType, BasicBatchValue<Scalar>(exponent));
+        });
+    } else if (isUnaryFunction) {
+        if (operand != secondOperand.end()) {
+            return Result<Job>(Error("unexpected token", tokenPosition(*operand)));
+        }
+        return Result<Job>(Job(first, operationType));
+    } else if (std::holds_alternative<BinaryComplexOperation>(operationType)) {
+        return processor.process(Flow<ComplexOperand>(secondOperand)).transform([&first, &operationType](BasicComplexNumber<Scalar>&& second) {
+            return Job(first, operationType, BasicBatchValue<Scalar>(second));
+        });
+    } else {
+        return processor.process(Flow<DoubleOperand>(secondOperand)).transform([&first, &operationType](Scalar&& second) {
+            return Job(first, operationType, BasicBatchValue<Scalar>(second));
+        });
+    }
+}
+
+template <typename Scalar>
+Result<BasicBatchValue<Scalar>> BasicBatchEvaluator<Scalar>::evaluate(std::string_view line) {
+    if (!cache.isEnabled()) {
+        return parse(line).and_then(calculate<Scalar>);
+    }
+
+    normalizeExpression(line, key);
+    if (auto job = cache.find(key)) {
+        return calculate(*job);
+    }
+
+    auto job = parse(line);
+    if (job.hasSuccess()) {
+        cache.insert(key, job.success());
+    }
+    return job.and_then(calculate<Scalar>);
+}
+
+template <typename Scalar>
+Result<BasicBatchValue<Scalar>> BasicExpressionEvaluator<Scalar>::evaluate(std::string_view line) {
+    typedef BasicBatchValue<Scalar> Value;
+
+    arena.reset();
+    if (!cache.isEnabled()) {
+        return compiler.compile(tokenizer.tokenize(line, arena.resource())).transform([this](BasicCompiledExpression<Scalar>&& expression) {
+            return Value(expression.evaluate(stack));
+        });
+    }
+
+    normalizeExpression(line, key);
+    if (auto expression = cache.find(key)) {
+        return Result<Value>(Value(expression->evaluate(stack)));
+    }
+
+    auto expression = compiler.compile(tokenizer.tokenize(line, arena.resource()));
+    if (expression.hasError()) {
+        return Result<Value>(std::move(expression).error());
+    }
+    auto value = expression.success().evaluate(stack);
+    cache.insert(key, std::move(expression).success());
+    return Result<Value>(Value(value));
+}
+
+// MARK: - Output
+
+template <typename Scalar>
+void appendResult(std::string& output, Result<BasicBatchValue<Scalar>>& result) {
+    StageTimer timer (Stage::FORMAT);
+    Metrics::count(Counter::LINES);
+    if (result.hasError()) {
+        Metrics::count(Counter::ERRORS);
+        auto& error = result.error();
+        output += "error: " + error.description;
+        if (error.position.has_value()) {
+            output += " at column " + std::to_string(error.position.value() + 1);
+        }
+    } else {
+        // Formatted straight into the output's spare capacity.
+        auto size = output.size();
+        output.resize(size + complexNumberCharsLength);
+        auto first = &output[size];
+        auto last = first + complexNumberCharsLength;
+        auto& value = result.success();
+        auto end = std::holds_alternative<Scalar>(value) ? std::to_chars(first, last, std::get<Scalar>(value)).ptr : std::get<BasicComplexNumber<Scalar>>(value).to_chars(first, last).ptr;
+        output.resize(end - output.data());
+    }
+    output += '\n';
+}
+
+template <typename Scalar>
+void appendResult(std::string& output, Result<BasicBatchValue<Scalar>>& result, BatchFormat format) {
+    if (format == BatchFormat::TEXT) {
+        appendResult(output, result);
+        return;
+    }
+
+    StageTimer timer (Stage::FORMAT);
+    Metrics::count(Counter::LINES);
+    if (result.hasError()) {
+        Metrics::count(Counter::ERRORS);
+        const double notANumber = std::numeric_limits<double>::quiet_NaN();
+        appendComplexRecord(output, ComplexNumber(notANumber, notANumber));
+        return;
+    }
+    auto& value = result.success();
+    if (std::holds_alternative<Scalar>(value)) {
+        appendComplexRecord(output, ComplexNumber(static_cast<double>(std::get<Scalar>(value)), 0));
+    } else {
+        auto& number = std::get<BasicComplexNumber<Scalar>>(value);
+        appendComplexRecord(output, ComplexNumber(static_cast<double>(number.getReal()), static_cast<double>(number.getImaginary())));
+    }
+}
+
+template <typename Scalar>
+void Batch::runWithPrecision(std::istream& input, std::ostream& output) {
+    if (pipelined && mode == BatchMode::OPERATION) {
+        Pipeline<Scalar>().run(input, output);
+        return;
+    }
+
+    BasicBatchEvaluator<Scalar> evaluator (mode == BatchMode::OPERATION ? cacheCapacity : 0);
+    BasicExpressionEvaluator<Scalar> expressionEvaluator (mode == BatchMode::EXPRESSION ? cacheCapacity : 0);
+    std::string line;
+    std::string buffer;
+    buffer.reserve(batchOutputBlock + 256);
+    if (outputFormat == BatchFormat::BINARY) {
+        appendComplexStreamHeader(buffer, ComplexLayout::INTERLEAVED, unknownComplexCount);
+    }
+
+    while (std::getline(input, line)) {
+        std::string_view expression (line);
+        if (!expression.empty() && expression.back() == '\r') {
+            expression.remove_suffix(1);
+        }
+
+        auto result = mode == BatchMode::EXPRESSION ? expressionEvaluator.evaluate(expression) : evaluator.evaluate(expression);
+        appendResult(buffer, result, outputFormat);
+
+        if (buffer.size() >= batchOutputBlock) {
+            output.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    output.write(buffer.data(), buffer.size());
+    output.flush();
+
+    statistics = mode == BatchMode::EXPRESSION ? expressionEvaluator.cacheStatistics() : evaluator.cacheStatistics();
+}
+
+void Batch::run(std::istream& input, std::ostream& output) {
+    switch (precision) {
+        case Precision::FLOAT:
+            return runWithPrecision<float>(input, output);
+        case Precision::DOUBLE:
+            return runWithPrecision<double>(input, output);
+        case Precision::LONG_DOUBLE:
+            return runWithPrecision<long double>(input, output);
+    }
+}
+
+// MARK: - In-Memory Input
+
+const size_t inputChunkSize = 1 << 20;
+
+// Cuts text after the first line end at or past every chunkSize bytes.
+std::vector<std::string_view> splitAtLines(std::string_view text, size_t chunkSize) {
+    std::vector<std::string_view> chunks;
+    while (!text.empty()) {
+        auto end = text.size() <= chunkSize ? std::string_view::npos : text.find('\n', chunkSize);
+        auto length = end == std::string_view::npos ? text.size() : end + 1;
+        chunks.push_back(text.substr(0, length));
+        text.remove_prefix(length);
+    }
+    return chunks;
+}
+
+void addStatistics(CacheStatistics& total, const CacheStatistics& part) {
+    total.hits += part.hits;
+    total.misses += part.misses;
+    total.evictions += part.evictions;
+}
+
+// Chunks are done a round at a time, a few per worker, and written before
+// the next round starts, so memory stays bounded for any input size.
+template <typename Scalar>
+void Batch::runWithPrecision(std::string_view input, std::ostream& output) {
+    ThreadPool pool (threadCount);
+    auto chunks = splitAtLines(input, inputChunkSize);
+    const size_t roundSize = pool.size() * 4;
+    std::vector<std::string> outputs (roundSize);
+    std::vector<CacheStatistics> chunkStatistics (roundSize);
+    statistics = CacheStatistics();
+    if (outputFormat == BatchFormat::BINARY) {
+        std::string header;
+        appendComplexStreamHeader(header, ComplexLayout::INTERLEAVED, unknownComplexCount);
+        output.write(header.data(), header.size());
+    }
+
+    for (size_t first = 0; first < chunks.size(); first += roundSize) {
+        size_t count = std::min(roundSize, chunks.size() - first);
+
+        pool.parallelFor(count, 1, [&](size_t begin, size_t end) {
+            for (size_t index = begin; index < end; ++index) {
+                outputs[index].clear();
+                if (mode == BatchMode::EXPRESSION) {
+                    BasicExpressionEvaluator<Scalar> evaluator (cacheCapacity);
+                    evaluateLines(chunks[first + index], evaluator, outputs[index], outputFormat);
+                    chunkStatistics[index] = evaluator.cacheStatistics();
+                } else {
+                    BasicBatchEvaluator<Scalar> evaluator (cacheCapacity);
+                    evaluateLines(chunks[first + index], evaluator, outputs[index], outputFormat);
+                    chunkStatistics[index] = evaluator.cacheStatistics();
+                }
+            }
+        });
+
+        for (size_t index = 0; index < count; ++index) {
+            output.write(outputs[index].data(), outputs[index].size());
+            addStatistics(statistics, chunkStatistics[index]);
+        }
+    }
+    output.flush();
+}
+
+void Batch::run(std::string_view input, std::ostream& output) {
+    switch (precision) {
+        case Precision::FLOAT:
+            return runWithPrecision<float>(input, output);
+        case Precision::DOUBLE:
+            return runWithPrecision<double>(input, output);
+        case Precision::LONG_DOUBLE:
+            return runWithPrecision<long double>(input, output);
+    }
+}
+
+// MARK: - Complex Stream Input
+
+// Numbers per chunk, about as many bytes as a text chunk.
+const size_t numberChunkSize = inputChunkSize / (2 * sizeof(double));
+
+template <typename Scalar>
+Result<size_t> Batch::runWithPrecision(const ComplexStreamView& input, std::string_view operation, std::ostream& output) {
+    typedef BasicBatchValue<Scalar> Value;
+
+    // The operation is parsed once, behind a placeholder first operand.
+    const std::string_view placeholder = "0 ";
+    bool isPassedThrough = operation.find_first_not_of(" \t\r") == std::string_view::npos;
+    auto job = BasicCalculationJob<Scalar>(BasicComplexNumber<Scalar>(), OperationType());
+    if (!isPassedThrough) {
+        std::string line (placeholder);
+        line += operation;
+        auto parsed = BasicBatchEvaluator<Scalar>(0).parse(line);
+        if (parsed.hasError()) {
+            auto error = std::move(parsed).error();
+            if (error.position.has_value()) {
+                error.position = error.position.value() < placeholder.size() ? 0 : error.position.value() - placeholder.size();
+            }
+            return Result<size_t>(std::move(error));
+        }
+        job = parsed.success();
+    }
+
+    ThreadPool pool (threadCount);
+    const size_t chunkCount = (input.size() + numberChunkSize - 1) / numberChunkSize;
+    const size_t roundSize = pool.size() * 4;
+    std::vector<std::string> outputs (roundSize);
+    statistics = CacheStatistics();
+    if (outputFormat == BatchFormat::BINARY) {
+        std::string header;
+        appendComplexStreamHeader(header, ComplexLayout::INTERLEAVED, input.size());
+        output.write(header.data(), header.size());
+    }
+
+    for (size_t first = 0; first < chunkCount; first += roundSize) {
+        size_t count = std::min(roundSize, chunkCount - first);
+
+        pool.parallelFor(count, 1, [&](size_t begin, size_t end) {
+            for (size_t index = begin; index < end; ++index) {
+                auto chunkJob = job;
+                auto& chunkOutput = outputs[index];
+                chunkOutput.clear();
+                size_t last = std::min(input.size(), (first + index + 1) * numberChunkSize);
+                for (size_t number = (first + index) * numberChunkSize; number < last; ++number) {
+                    auto value = input[number];
+                    chunkJob.firstOperand = BasicComplexNumber<Scalar>(static_cast<Scalar>(value.getReal()), static_cast<Scalar>(value.getImaginary()));
+                    auto result = isPassedThrough ? Result<Value>(Value(chunkJob.firstOperand)) : calculate(chunkJob);
+                    appendResult(chunkOutput, result, outputFormat);
+                }
+            }
+        });
+
+        for (size_t index = 0; index < count; ++index) {
+            output.write(outputs[index].data(), outputs[index].size());
+        }
+    }
+    output.flush();
+    return Result<size_t>(input.size());
+}
+
+Result<size_t> Batch::run(const ComplexStreamView& input, std::string_view operation, std::ostream& output) {
+    switch (precision) {
+        case Precision::FLOAT:
+            return runWithPrecision<float>(input, operation, output);
+        case Precision::DOUBLE:
+            return runWithPrecision<double>(input, operation, output);
+        case Precision::LONG_DOUBLE:
+            return runWithPrecision<long double>(input, operation, output);
+    }
+    return Result<size_t>(Error("unknown precision"));
+}
+
+// MARK: - Instantiations
+
+template Result<BasicBatchValue<float>> calculate(const BasicCalculationJob<float>& job);
+template Result<BasicBatchValue<double>> calculate(const BasicCalculationJob<double>& job);
+template Result<BasicBatchValue<long double>> calculate(const BasicCalculationJob<long double>& job);
+
+template std::vector<Result<BasicBatchValue<float>>> evaluate(const std::vector<BasicCalculationJob<float>>& jobs, ThreadPool& pool, size_t grain);
+template std::vector<Result<BasicBatchValue<double>>> evaluate(const std::vector<BasicCalculationJob<double>>& jobs, ThreadPool& pool, size_t grain);
+template std::vector<Result<BasicBatchValue<long double>>> evaluate(const std::vector<BasicCalculationJob<long double>>& jobs, ThreadPool& pool, size_t grain);
+
+template void appendResult(std::string& output, Result<BasicBatchValue<float>>& result);
+template void appendResult(std::string& output, Result<BasicBatchValue<double>>& result);
+template void appendResult(std::string& output, Result<BasicBatchValue<long double>>& result);
+
+template void appendResult(std::string& output, Result<BasicBatchValue<float>>& result, BatchFormat format);
+template void appendResult(std::string& output, Result<BasicBatchValue<double>>& result, BatchFormat format);
+template void appendResult(std::string& output, Result<BasicBatchValue<long double>>& result, BatchFormat format);
+
+template class BasicBatchEvaluator<float>;
+template class BasicBatchEvaluator<double>;
+template class BasicBatchEvaluator<long double>;
+
+template class BasicExpressionEvaluator<float>;
+template class BasicExpressionEvaluator<double>;
+template class BasicExpressionEvaluator<long double>;
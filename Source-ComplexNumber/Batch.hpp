@@ -0,0 +1,216 @@
+//
+//  Batch.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef Batch_hpp
+#define Batch_hpp
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "ComplexNumber.hpp"
+#include "ComplexStream.hpp"
+#include "Expression.hpp"
+#include "ExpressionCache.hpp"
+#include "Tokenizer.hpp"
+#include "FlowProcessor.hpp"
+#include "RequestArena.hpp"
+#include "Result.hpp"
+#include "ThreadPool.hpp"
+
+template <typename Scalar>
+using BasicBatchValue = std::variant<BasicComplexNumber<Scalar>, Scalar>;
+
+typedef BasicBatchValue<double> BatchValue;
+
+// One parsed calculation: the operation as FlowProcessor::process(Flow<Operation>)
+// returns it and its operands. secondOperand holds the exponent of POWER
+// and ROOT and is ignored for other Functions; it must hold a complex
+// number for a BinaryComplexOperation and a scalar for a
+// BinaryComplexDoubleOperation.
+template <typename Scalar>
+struct BasicCalculationJob {
+    BasicComplexNumber<Scalar> firstOperand;
+    OperationType operation;
+    BasicBatchValue<Scalar> secondOperand;
+
+    BasicCalculationJob(BasicComplexNumber<Scalar> firstOperand, OperationType operation, BasicBatchValue<Scalar> secondOperand = BasicBatchValue<Scalar>(Scalar(0))): firstOperand(firstOperand), operation(operation), secondOperand(secondOperand) {};
+};
+
+typedef BasicCalculationJob<double> CalculationJob;
+
+template <typename Scalar>
+Result<BasicBatchValue<Scalar>> calculate(const BasicCalculationJob<Scalar>& job);
+
+// Calculates already parsed jobs on pool, in chunks of at least grain jobs
+// (0 lets parallelFor pick), and returns each job's result at its index.
+template <typename Scalar>
+std::vector<Result<BasicBatchValue<Scalar>>> evaluate(const std::vector<BasicCalculationJob<Scalar>>& jobs, ThreadPool& pool, size_t grain = 0);
+
+const size_t defaultCacheCapacity = 4096;
+
+// Evaluates one complete expression per line, e.g. "2+i3 * 4",
+// "1-i2 modulus" or "1+i power 5". The line is split at its first operation or function
+// token and the parts go through the same flows the console uses.
+// Parsed lines are cached, so a repeated line is only calculated; lines
+// with errors are not cached and always report their own columns. A line's
+// tokens and flows live in arena, which is reset for every line.
+template <typename Scalar>
+class BasicBatchEvaluator {
+private:
+    Tokenizer tokenizer = Tokenizer();
+    BasicFlowProcessor<Scalar> processor = BasicFlowProcessor<Scalar>();
+    RequestArena arena;
+    TokenList firstOperand;
+    TokenList operation;
+    TokenList secondOperand;
+    ExpressionCache<BasicCalculationJob<Scalar>> cache;
+    std::string key;
+
+    Result<BasicCalculationJob<Scalar>> parseSecondOperand(BasicComplexNumber<Scalar>& first, OperationType& operationType);
+public:
+    explicit BasicBatchEvaluator(size_t cacheCapacity = defaultCacheCapacity): cache(cacheCapacity) {};
+
+    Result<BasicCalculationJob<Scalar>> parse(std::string_view line);
+    Result<BasicCalculationJob<Scalar>> parse(const TokenList& tokens);
+    Result<BasicBatchValue<Scalar>> evaluate(std::string_view line);
+
+    const CacheStatistics& cacheStatistics() const { return cache.getStatistics(); }
+};
+
+typedef BasicBatchEvaluator<double> BatchEvaluator;
+
+// Whole arithmetic expressions with precedence and parentheses, e.g.
+// "(2+i3)*(1-i)/4 + modulus(3+i4)", compiled by ExpressionCompiler.
+// The stack holds lazy numbers, so chains of *, / and powers run in
+// polar form.
+// Compiled programs are cached like BatchEvaluator's parsed lines.
+//
+// Unlike the stateless Tokenizer and processors, both evaluators own
+// scratch state (arena, token lists, stack, cache) that every call
+// rewrites: use one per thread, as Batch's workers and the server's
+// evaluator pool do.
+template <typename Scalar>
+class BasicExpressionEvaluator {
+private:
+    Tokenizer tokenizer = Tokenizer();
+    RequestArena arena;
+    BasicExpressionCompiler<Scalar> compiler = BasicExpressionCompiler<Scalar>();
+    std::vector<BasicLazyComplexNumber<Scalar>> stack;
+    ExpressionCache<BasicCompiledExpression<Scalar>> cache;
+    std::string key;
+public:
+    explicit BasicExpressionEvaluator(size_t cacheCapacity = defaultCacheCapacity): cache(cacheCapacity) {};
+
+    Result<BasicBatchValue<Scalar>> evaluate(std::string_view line);
+
+    const CacheStatistics& cacheStatistics() const { return cache.getStatistics(); }
+};
+
+typedef BasicExpressionEvaluator<double> ExpressionEvaluator;
+
+// TEXT is a line per result, as below; BINARY an INTERLEAVED complex
+// stream (see ComplexStream.hpp) of one number per result, at double
+// precision whatever the Scalar. In a stream a real result has a zero
+// imaginary part and an error is a NaN pair.
+enum class BatchFormat {
+    TEXT,
+    BINARY
+};
+
+// The text line: the value in its shortest exact form, or "error: " and
+// the description.
+template <typename Scalar>
+void appendResult(std::string& output, Result<BasicBatchValue<Scalar>>& result);
+
+template <typename Scalar>
+void appendResult(std::string& output, Result<BasicBatchValue<Scalar>>& result, BatchFormat format);
+
+// Evaluates every line of text in memory, appending a result in format
+// to output for each. The lines are the same getline would give: split at
+// '\n', a trailing '\r' dropped and no empty line after a final line end.
+template <typename Evaluator>
+void evaluateLines(std::string_view text, Evaluator& evaluator, std::string& output, BatchFormat format = BatchFormat::TEXT) {
+    while (!text.empty()) {
+        auto end = text.find('\n');
+        auto line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        auto result = evaluator.evaluate(line);
+        appendResult(output, result, format);
+
+        if (end == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(end + 1);
+    }
+}
+
+// Output is collected and written in blocks of about this many bytes.
+const size_t batchOutputBlock = 1 << 16;
+
+// What a line holds: OPERATION is --batch's "operand operation operand",
+// EXPRESSION --eval's arithmetic expression.
+enum class BatchMode {
+    OPERATION,
+    EXPRESSION
+};
+
+enum class Precision {
+    FLOAT,
+    DOUBLE,
+    LONG_DOUBLE
+};
+
+// Non-interactive front end: no prompts, one result per input line and
+// output flushed in large blocks. Lines are parsed and calculated at the
+// chosen precision. After a run, statistics holds the cache counters of
+// the evaluator used. pipelined runs OPERATION mode as a Pipeline, one thread
+// per stage and without the cache, and writes TEXT only.
+struct Batch {
+    BatchMode mode;
+    size_t cacheCapacity;
+    Precision precision = Precision::DOUBLE;
+    BatchFormat outputFormat = BatchFormat::TEXT;
+    bool pipelined = false;
+    size_t threadCount = std::thread::hardware_concurrency();
+    CacheStatistics statistics;
+
+    Batch(BatchMode mode = BatchMode::OPERATION, size_t cacheCapacity = defaultCacheCapacity): mode(mode), cacheCapacity(cacheCapacity) {};
+
+    void run(std::istream& input, std::ostream& output);
+
+    // Whole input already in memory, e.g. a MappedFile. Lines are sliced in
+    // place and the text is cut at line ends into chunks that threadCount
+    // workers evaluate side by side, each with its own evaluator and cache.
+    // Output keeps the input order.
+    void run(std::string_view input, std::ostream& output);
+
+    // Numbers rather than lines: every number of the stream is the first
+    // operand of operation, e.g. "* 2", "power 3" or "+ 1-i", whatever the
+    // mode; an empty operation passes the numbers through. Chunks of
+    // numbers are calculated side by side like run(std::string_view)'s.
+    // Returns how many numbers there were, or, before anything is written,
+    // why operation doesn't parse.
+    Result<size_t> run(const ComplexStreamView& input, std::string_view operation, std::ostream& output);
+private:
+    template <typename Scalar>
+    void runWithPrecision(std::istream& input, std::ostream& output);
+
+    template <typename Scalar>
+    void runWithPrecision(std::string_view input, std::ostream& output);
+
+    template <typename Scalar>
+    Result<size_t> runWithPrecision(const ComplexStreamView& input, std::string_view operation, std::ostream& output);
+};
+
+#endif /* Batch_hpp */
@@ -8,30 +8,106 @@
 #ifndef Calculator_hpp
 #define Calculator_hpp
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
 #include "FlowProcessor.hpp"
+#include "Instrumentation.hpp"
 #include "ComplexNumber.hpp"
+#include "PolarNumber.hpp"
 
+// Operations are plain enums: the runtime overloads switch once and call the
+// templated kernels, which hot loops can also instantiate directly when the
+// operation is known up front. Every kernel is instantiated per precision
+// tier from the scalar type of its operands. All of them are pure functions
+// of their arguments and safe to call from any thread.
 struct Calculator {
-    static double calculate(ComplexNumber& operand, Function& method) {
+    template <BinaryComplexOperation operation, typename Scalar>
+    static BasicComplexNumber<Scalar> apply(BasicComplexNumber<Scalar> first, BasicComplexNumber<Scalar> second) {
+        if constexpr (operation == BinaryComplexOperation::PLUS) {
+            return first + second;
+        } else {
+            return first - second;
+        }
+    };
+
+    template <BinaryComplexDoubleOperation operation, typename Scalar>
+    static BasicComplexNumber<Scalar> apply(BasicComplexNumber<Scalar> first, Scalar second) {
+        if constexpr (operation == BinaryComplexDoubleOperation::MULTIPLY) {
+            return first * second;
+        } else {
+            return first / second;
+        }
+    };
+
+    // The real-valued functions; the others give NaN here.
+    template <typename Scalar>
+    static Scalar calculate(const BasicComplexNumber<Scalar>& operand, Function method) {
+        StageTimer timer (Stage::CALCULATE);
         switch (method) {
             case Function::MODULUS:
                 return operand.modulus();
             case Function::ARGUMENT:
                 return operand.argument();
+            default:
+                return std::numeric_limits<Scalar>::quiet_NaN();
         }
     };
 
-    static double calculate(double& operand, Function& method) {
-        ComplexNumber complex (operand, 0);
+    template <typename Scalar, typename = std::enable_if_t<std::is_floating_point<Scalar>::value>>
+    static Scalar calculate(const Scalar& operand, Function method) {
+        BasicComplexNumber<Scalar> complex (operand, 0);
         return Calculator::calculate(complex, method);
     };
 
-    static ComplexNumber calculate(std::pair<ComplexNumber, ComplexNumber> operands, BinaryComplexOperation& operation) {
-        return operation(operands.first, operands.second);
+    // Any function as a complex number, with the second operand as the
+    // exponent of POWER and ROOT. Goes through BasicLazyComplexNumber, so
+    // each function takes the same path as in a compiled expression.
+    template <typename Scalar>
+    static BasicComplexNumber<Scalar> calculate(std::pair<BasicComplexNumber<Scalar>, Scalar> operands, Function function) {
+        StageTimer timer (Stage::CALCULATE);
+        BasicLazyComplexNumber<Scalar> operand (operands.first);
+        switch (function) {
+            case Function::MODULUS:
+                return BasicComplexNumber<Scalar>(operand.modulus());
+            case Function::ARGUMENT:
+                return BasicComplexNumber<Scalar>(operand.argument());
+            case Function::POWER:
+                return operand.power(BasicComplexNumber<Scalar>(operands.second)).cartesianForm();
+            case Function::ROOT:
+                return operand.root(BasicComplexNumber<Scalar>(operands.second)).cartesianForm();
+            case Function::EXPONENT:
+                return operand.exponential().cartesianForm();
+            case Function::LOGARITHM:
+                return operand.logarithm().cartesianForm();
+        }
+        return operands.first;
     };
 
-    static ComplexNumber calculate(std::pair<ComplexNumber, double> operands, BinaryComplexDoubleOperation& operation) {
-        return operation(operands.first, operands.second);
+    template <typename Scalar>
+    static BasicComplexNumber<Scalar> calculate(std::pair<BasicComplexNumber<Scalar>, BasicComplexNumber<Scalar>> operands, BinaryComplexOperation operation) {
+        StageTimer timer (Stage::CALCULATE);
+        switch (operation) {
+            case BinaryComplexOperation::PLUS:
+                return apply<BinaryComplexOperation::PLUS>(operands.first, operands.second);
+            case BinaryComplexOperation::MINUS:
+                return apply<BinaryComplexOperation::MINUS>(operands.first, operands.second);
+        }
+        return operands.first;
+    };
+
+    template <typename Scalar>
+    static BasicComplexNumber<Scalar> calculate(std::pair<BasicComplexNumber<Scalar>, Scalar> operands, BinaryComplexDoubleOperation operation) {
+        StageTimer timer (Stage::CALCULATE);
+        switch (operation) {
+            case BinaryComplexDoubleOperation::MULTIPLY:
+                return apply<BinaryComplexDoubleOperation::MULTIPLY>(operands.first, operands.second);
+            case BinaryComplexDoubleOperation::DIVIDE:
+                return apply<BinaryComplexDoubleOperation::DIVIDE>(operands.first, operands.second);
+        }
+        return operands.first;
     };
 };
 
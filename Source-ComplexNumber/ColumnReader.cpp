@@ -0,0 +1,357 @@
+//
+//  ColumnReader.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ColumnReader.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define COLUMN_READER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define COLUMN_READER_AVX2
+#else
+#define COLUMN_READER_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+const size_t columnChunkSize = 1 << 20;
+
+// MARK: - Classification
+
+// Bit i of each mask stands for byte i of a 64-byte block.
+struct BlockMasks {
+    uint64_t separators;
+    uint64_t newlines;
+};
+
+typedef BlockMasks (*BlockClassifier)(const char* block);
+
+constexpr bool isSeparator(char symbol) {
+    return symbol == ' ' || symbol == '\t' || symbol == ',' || symbol == ';' || symbol == '\r';
+}
+
+constexpr bool isDelimiter(char symbol) {
+    return isSeparator(symbol) || symbol == '\n';
+}
+
+BlockMasks classifyScalar(const char* block) {
+    BlockMasks masks {0, 0};
+    for (size_t index = 0; index < 64; ++index) {
+        masks.separators |= uint64_t(isSeparator(block[index])) << index;
+        masks.newlines |= uint64_t(block[index] == '\n') << index;
+    }
+    return masks;
+}
+
+#ifdef COLUMN_READER_X86
+
+BlockMasks classifySSE2(const char* block) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i semicolon = _mm_set1_epi8(';');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    BlockMasks masks {0, 0};
+    for (int part = 0; part < 4; ++part) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16*part));
+        __m128i separators = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, space), _mm_cmpeq_epi8(bytes, tab)), _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, semicolon)));
+        separators = _mm_or_si128(separators, _mm_cmpeq_epi8(bytes, carriageReturn));
+        masks.separators |= uint64_t(uint32_t(_mm_movemask_epi8(separators))) << (16*part);
+        masks.newlines |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))) << (16*part);
+    }
+    return masks;
+}
+
+// Nibble lookup: every delimiter has one bit, set in the entry for its low
+// nibble and in the one for its high nibble, so a byte is that delimiter
+// exactly when both lookups share the bit. Bits 0-4 are the separators
+// ' ', '\t', '\r', ',' and ';', bit 5 is '\n'.
+COLUMN_READER_AVX2 BlockMasks classifyAVX2(const char* block) {
+    const __m256i lowNibbles = _mm256_setr_epi8(
+        0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x20, 0x10, 0x08, 0x04, 0, 0,
+        0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x20, 0x10, 0x08, 0x04, 0, 0);
+    const __m256i highNibbles = _mm256_setr_epi8(
+        0x26, 0, 0x09, 0x10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x26, 0, 0x09, 0x10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i separatorBits = _mm256_set1_epi8(0x1F);
+    const __m256i newlineBit = _mm256_set1_epi8(0x20);
+    const __m256i zero = _mm256_setzero_si256();
+
+    BlockMasks masks {0, 0};
+    for (int part = 0; part < 2; ++part) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32*part));
+        __m256i low = _mm256_shuffle_epi8(lowNibbles, _mm256_and_si256(bytes, nibble));
+        __m256i high = _mm256_shuffle_epi8(highNibbles, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+        __m256i classes = _mm256_and_si256(low, high);
+        __m256i separators = _mm256_cmpeq_epi8(_mm256_and_si256(classes, separatorBits), zero);
+        __m256i newlines = _mm256_cmpeq_epi8(_mm256_and_si256(classes, newlineBit), zero);
+        masks.separators |= uint64_t(~uint32_t(_mm256_movemask_epi8(separators))) << (32*part);
+        masks.newlines |= uint64_t(~uint32_t(_mm256_movemask_epi8(newlines))) << (32*part);
+    }
+    return masks;
+}
+
+#endif
+
+BlockClassifier blockClassifier(SimdLevel level) {
+    if (level > supportedSimdLevel()) {
+        level = supportedSimdLevel();
+    }
+    switch (level) {
+#ifdef COLUMN_READER_X86
+        case SimdLevel::AVX2:
+            return classifyAVX2;
+        case SimdLevel::SSE2:
+            return classifySSE2;
+#endif
+        default:
+            return classifyScalar;
+    }
+}
+
+inline size_t trailingZeros(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// MARK: - Numbers
+
+constexpr double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool isLittleEndian = false;
+#else
+constexpr bool isLittleEndian = true;
+#endif
+
+constexpr uint64_t powersOfTen[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+// How many of the eight bytes in a little-endian word are ASCII digits
+// before the first other byte. A digit byte turns into 0x33: its high
+// nibble is 3 and adding 6 keeps it 3. A carry out of a byte above 0xF9
+// only reaches bytes after that non-digit.
+inline size_t leadingDigits(uint64_t chunk) {
+    uint64_t classes = (chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4);
+    uint64_t others = classes ^ 0x3333333333333333;
+    return others == 0 ? 8 : trailingZeros(others) >> 3;
+}
+
+// The first count digits of the word, count from 1 to 8: they are moved
+// to the top, behind '0's, and combined pairwise, then in fours, then all
+// eight, in three multiplies.
+inline uint64_t digitsValue(uint64_t chunk, size_t count) {
+    if (count < 8) {
+        chunk = (chunk << (8*(8 - count))) | (0x3030303030303030 >> (8*count));
+    }
+    const uint64_t mask = 0x000000FF000000FF;
+    const uint64_t hundredAndMillion = 100 + (1000000ULL << 32);
+    const uint64_t oneAndTenThousand = 1 + (10000ULL << 32);
+    chunk -= 0x3030303030303030;
+    chunk = chunk*10 + (chunk >> 8);
+    return (((chunk & mask)*hundredAndMillion + ((chunk >> 16) & mask)*oneAndTenThousand) >> 32) & 0xFFFFFFFF;
+}
+
+// Appends the digits at position to mantissa, up to eight per step where
+// eight bytes are left to load. mantissa wraps past 19 digits; the caller
+// checks the count.
+inline const char* readDigits(const char* position, const char* last, uint64_t& mantissa, size_t& digits) {
+    if constexpr (isLittleEndian) {
+        while (last - position >= 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, position, 8);
+            size_t count = leadingDigits(chunk);
+            if (count == 0) {
+                return position;
+            }
+            mantissa = mantissa*powersOfTen[count] + digitsValue(chunk, count);
+            position += count;
+            digits += count;
+            if (count < 8) {
+                return position;
+            }
+        }
+    }
+    while (position != last && static_cast<unsigned char>(*position - '0') < 10) {
+        mantissa = mantissa*10 + static_cast<uint64_t>(*position - '0');
+        ++position;
+        ++digits;
+    }
+    return position;
+}
+
+// A decimal with at most 19 digits, no exponent, a mantissa below 2^53
+// and at most 22 fraction digits is one exact conversion and one correctly
+// rounded division, which is what from_chars gives for it too.
+// Returns the end of the number, or nullptr when there is none.
+const char* parseNumber(const char* first, const char* last, double& value) {
+    const char* position = first;
+    const bool isNegative = *position == '-';
+    if (*position == '-' || *position == '+') {
+        ++position;
+    }
+
+    uint64_t mantissa = 0;
+    size_t digits = 0;
+    position = readDigits(position, last, mantissa, digits);
+    size_t integerDigits = digits;
+    if (position != last && *position == '.') {
+        position = readDigits(position + 1, last, mantissa, digits);
+    }
+    size_t fractionDigits = digits - integerDigits;
+
+    const bool hasExponent = position != last && (*position == 'e' || *position == 'E');
+    if (digits > 0 && digits <= 19 && !hasExponent && mantissa <= (uint64_t(1) << 53) && fractionDigits <= 22) {
+        const double magnitude = static_cast<double>(mantissa) / exactPowersOfTen[fractionDigits];
+        value = isNegative ? -magnitude : magnitude;
+        return position;
+    }
+
+    // from_chars takes a '-' but no '+'.
+    if (*first == '+' && (first + 1 == last || first[1] == '-')) {
+        return nullptr;
+    }
+    auto result = std::from_chars(*first == '+' ? first + 1 : first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+// MARK: - Chunks
+
+struct ChunkColumns {
+    std::vector<double> real;
+    std::vector<double> imaginary;
+    size_t errorOffset = 0;
+    const char* errorDescription = nullptr;
+
+    bool fail(size_t offset, const char* description) {
+        errorOffset = offset;
+        errorDescription = description;
+        return false;
+    }
+};
+
+// Fields start at a non-delimiter after a delimiter, which the shifted
+// mask finds for a whole block at once; carry brings the last byte of the
+// previous block along. Field starts and line ends are then visited in
+// order. The chunk starts a line, so the byte before it counts as a line end.
+void readChunk(std::string_view text, size_t begin, size_t end, BlockClassifier classify, ChunkColumns& columns) {
+    const char* data = text.data();
+    const char* last = data + end;
+    columns.real.reserve((end - begin) / 16);
+    columns.imaginary.reserve((end - begin) / 16);
+
+    size_t fields = 0;
+    double parts[2] = {0, 0};
+    uint64_t carry = 1;
+    char padded[64];
+
+    auto finishLine = [&](size_t offset) {
+        if (fields == 1) {
+            return columns.fail(offset, "expected 2 columns");
+        }
+        if (fields == 2) {
+            columns.real.push_back(parts[0]);
+            columns.imaginary.push_back(parts[1]);
+        }
+        fields = 0;
+        return true;
+    };
+
+    for (size_t offset = begin; offset < end; offset += 64) {
+        const char* block = data + offset;
+        if (end - offset < 64) {
+            std::memcpy(padded, block, end - offset);
+            std::memset(padded + (end - offset), ' ', 64 - (end - offset));
+            block = padded;
+        }
+
+        auto masks = classify(block);
+        uint64_t delimiters = masks.separators | masks.newlines;
+        uint64_t starts = ~delimiters & ((delimiters << 1) | carry);
+        carry = delimiters >> 63;
+
+        for (uint64_t events = starts | masks.newlines; events != 0; events &= events - 1) {
+            size_t position = offset + trailingZeros(events);
+            if (data[position] == '\n') {
+                if (!finishLine(position)) {
+                    return;
+                }
+                continue;
+            }
+            if (fields == 2) {
+                columns.fail(position, "expected 2 columns");
+                return;
+            }
+            auto numberEnd = parseNumber(data + position, last, parts[fields]);
+            if (numberEnd == nullptr || (numberEnd != last && !isDelimiter(*numberEnd))) {
+                columns.fail(position, "invalid number");
+                return;
+            }
+            fields += 1;
+        }
+    }
+    finishLine(end);
+}
+
+// MARK: - Reading
+
+Result<ComplexArray> ColumnReader::read(std::string_view text) {
+    auto classify = blockClassifier(level);
+
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t begin = 0; begin < text.size();) {
+        auto lineEnd = text.size() - begin <= columnChunkSize ? std::string_view::npos : text.find('\n', begin + columnChunkSize);
+        size_t end = lineEnd == std::string_view::npos ? text.size() : lineEnd + 1;
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+
+    std::vector<ChunkColumns> parts (chunks.size());
+    pool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+            readChunk(text, chunks[index].first, chunks[index].second, classify, parts[index]);
+        }
+    });
+
+    std::vector<size_t> offsets (parts.size() + 1, 0);
+    for (size_t index = 0; index < parts.size(); ++index) {
+        const auto& part = parts[index];
+        if (part.errorDescription != nullptr) {
+            auto line = std::count(text.begin(), text.begin() + part.errorOffset, '\n') + 1;
+            // npos + 1 wraps to 0 on the first line.
+            size_t lineStart = part.errorOffset == 0 ? 0 : text.rfind('\n', part.errorOffset - 1) + 1;
+            return Result<ComplexArray>(Error(std::string(part.errorDescription) + " on line " + std::to_string(line), part.errorOffset - lineStart));
+        }
+        offsets[index + 1] = offsets[index] + part.real.size();
+    }
+
+    ComplexArray numbers (offsets.back());
+    pool.parallelFor(parts.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+            std::copy(parts[index].real.begin(), parts[index].real.end(), numbers.realData() + offsets[index]);
+            std::copy(parts[index].imaginary.begin(), parts[index].imaginary.end(), numbers.imaginaryData() + offsets[index]);
+        }
+    });
+    return Result<ComplexArray>(std::move(numbers));
+}
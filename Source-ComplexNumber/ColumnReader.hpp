@@ -0,0 +1,44 @@
+//
+//  ColumnReader.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef ColumnReader_hpp
+#define ColumnReader_hpp
+
+#include <string_view>
+#include <thread>
+
+#include "ComplexArray.hpp"
+#include "Result.hpp"
+#include "ThreadPool.hpp"
+
+// Bulk reader for columnar text: one complex number per line as its real
+// and imaginary parts, e.g. "1.5,-2", "1.5;-2" or "1.5 \t -2". Spaces,
+// tabs, commas, semicolons and '\r' all separate columns, runs of them
+// count once and blank lines are skipped.
+//
+// The text is cut at line ends into chunks that are read side by side on
+// the pool, straight into a ComplexArray. Within a chunk, separators and
+// line ends are found 64 bytes at a time with vector compares (SSE2 or
+// AVX2, as level allows), and plain decimals of up to 19 digits are
+// converted eight digits per step in a 64-bit register. Anything else,
+// exponents and "inf" included, goes through std::from_chars; the results
+// are the same as from_chars gives everywhere.
+class ColumnReader {
+private:
+    ThreadPool pool;
+    SimdLevel level;
+public:
+    explicit ColumnReader(size_t threadCount = std::thread::hardware_concurrency(), SimdLevel level = supportedSimdLevel()): pool(threadCount), level(level) {};
+
+    size_t threadCount() const { return pool.size(); }
+
+    // The first malformed line in the text fails the whole read; the error
+    // names the line and its position is the column within it.
+    Result<ComplexArray> read(std::string_view text);
+};
+
+#endif /* ColumnReader_hpp */
@@ -0,0 +1,695 @@
+//
+//  ComplexArray.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#define _USE_MATH_DEFINES
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#include "ComplexArray.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define COMPLEX_ARRAY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define COMPLEX_ARRAY_AVX2
+#else
+#define COMPLEX_ARRAY_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// MARK: - Scalar Kernels
+
+void addScalar(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        real[index] = lhsReal[index] + rhsReal[index];
+        imaginary[index] = lhsImaginary[index] + rhsImaginary[index];
+    }
+}
+
+void subtractScalar(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        real[index] = lhsReal[index] - rhsReal[index];
+        imaginary[index] = lhsImaginary[index] - rhsImaginary[index];
+    }
+}
+
+void multiplyScalar(const double* lhsReal, const double* lhsImaginary, double factor, double* real, double* imaginary, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        real[index] = lhsReal[index] * factor;
+        imaginary[index] = lhsImaginary[index] * factor;
+    }
+}
+
+void divideScalar(const double* lhsReal, const double* lhsImaginary, double divisor, double* real, double* imaginary, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        real[index] = lhsReal[index] / divisor;
+        imaginary[index] = lhsImaginary[index] / divisor;
+    }
+}
+
+void modulusScalar(const double* real, const double* imaginary, double* result, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        result[index] = ComplexNumber(real[index], imaginary[index]).modulus();
+    }
+}
+
+template <ArgumentAccuracy accuracy>
+void argumentScalar(const double* real, const double* imaginary, double* result, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        result[index] = atan2Scalar<accuracy>(imaginary[index], real[index]);
+    }
+}
+
+template <ArgumentAccuracy accuracy>
+void argumentInterleavedScalar(const ComplexNumber* numbers, double* result, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        result[index] = atan2Scalar<accuracy>(numbers[index].getImaginary(), numbers[index].getReal());
+    }
+}
+
+void argumentScalar(const double* real, const double* imaginary, double* result, size_t count, ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return argumentScalar<ArgumentAccuracy::FULL>(real, imaginary, result, count);
+        case ArgumentAccuracy::FAST:
+            return argumentScalar<ArgumentAccuracy::FAST>(real, imaginary, result, count);
+        case ArgumentAccuracy::COARSE:
+            return argumentScalar<ArgumentAccuracy::COARSE>(real, imaginary, result, count);
+    }
+}
+
+void modulusInterleavedScalar(const ComplexNumber* numbers, double* result, size_t count) {
+    for (size_t index = 0; index < count; ++index) {
+        result[index] = numbers[index].modulus();
+    }
+}
+
+void argumentInterleavedScalar(const ComplexNumber* numbers, double* result, size_t count, ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return argumentInterleavedScalar<ArgumentAccuracy::FULL>(numbers, result, count);
+        case ArgumentAccuracy::FAST:
+            return argumentInterleavedScalar<ArgumentAccuracy::FAST>(numbers, result, count);
+        case ArgumentAccuracy::COARSE:
+            return argumentInterleavedScalar<ArgumentAccuracy::COARSE>(numbers, result, count);
+    }
+}
+
+const ComplexArrayKernels scalarKernels = {
+    addScalar,
+    subtractScalar,
+    multiplyScalar,
+    divideScalar,
+    modulusScalar,
+    argumentScalar,
+    modulusInterleavedScalar,
+    argumentInterleavedScalar
+};
+
+#ifdef COMPLEX_ARRAY_X86
+
+// MARK: - SSE2 Kernels
+
+inline __m128d selectSSE2(__m128d mask, __m128d ifTrue, __m128d ifFalse) {
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+// Sign bit of each lane spread over the whole lane.
+inline __m128d signMaskSSE2(__m128d x) {
+    return _mm_castsi128_pd(_mm_srai_epi32(_mm_shuffle_epi32(_mm_castpd_si128(x), _MM_SHUFFLE(3, 3, 1, 1)), 31));
+}
+
+template <size_t degree>
+inline __m128d atanPolynomialSSE2(const double (&coefficients)[degree], __m128d x) {
+    __m128d square = _mm_mul_pd(x, x);
+    __m128d polynomial = _mm_set1_pd(coefficients[0]);
+    for (size_t index = 1; index < degree; ++index) {
+        polynomial = _mm_add_pd(_mm_mul_pd(polynomial, square), _mm_set1_pd(coefficients[index]));
+    }
+    return _mm_mul_pd(x, polynomial);
+}
+
+template <ArgumentAccuracy accuracy>
+inline __m128d atanUnitSSE2(__m128d x) {
+    if constexpr (accuracy == ArgumentAccuracy::FULL) {
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d middle = _mm_cmpgt_pd(x, _mm_set1_pd(0.66));
+        __m128d reduced = selectSSE2(middle, _mm_div_pd(_mm_sub_pd(x, one), _mm_add_pd(x, one)), x);
+        __m128d offset = selectSSE2(middle, _mm_set1_pd(M_PI_4), _mm_setzero_pd());
+        __m128d moreBits = selectSSE2(middle, _mm_set1_pd(0.5 * atanMoreBits), _mm_setzero_pd());
+
+        __m128d square = _mm_mul_pd(reduced, reduced);
+        __m128d numerator = _mm_set1_pd(atanP[0]);
+        for (int index = 1; index < 5; ++index) {
+            numerator = _mm_add_pd(_mm_mul_pd(numerator, square), _mm_set1_pd(atanP[index]));
+        }
+        __m128d denominator = _mm_add_pd(square, _mm_set1_pd(atanQ[0]));
+        for (int index = 1; index < 5; ++index) {
+            denominator = _mm_add_pd(_mm_mul_pd(denominator, square), _mm_set1_pd(atanQ[index]));
+        }
+
+        __m128d tail = _mm_div_pd(_mm_mul_pd(square, numerator), denominator);
+        tail = _mm_add_pd(_mm_mul_pd(reduced, tail), reduced);
+        return _mm_add_pd(offset, _mm_add_pd(tail, moreBits));
+    } else if constexpr (accuracy == ArgumentAccuracy::FAST) {
+        return atanPolynomialSSE2(atanFast, x);
+    } else {
+        return atanPolynomialSSE2(atanCoarse, x);
+    }
+}
+
+template <ArgumentAccuracy accuracy>
+inline __m128d atan2SSE2(__m128d imaginary, __m128d real) {
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    __m128d realMagnitude = _mm_andnot_pd(signMask, real);
+    __m128d imaginaryMagnitude = _mm_andnot_pd(signMask, imaginary);
+    __m128d largest = _mm_max_pd(realMagnitude, imaginaryMagnitude);
+    __m128d smallest = _mm_min_pd(realMagnitude, imaginaryMagnitude);
+
+    __m128d ratio = _mm_div_pd(smallest, largest);
+    ratio = selectSSE2(_mm_cmpeq_pd(largest, zero), zero, ratio);
+    ratio = selectSSE2(_mm_cmpeq_pd(smallest, _mm_set1_pd(INFINITY)), _mm_set1_pd(1.0), ratio);
+
+    __m128d angle = atanUnitSSE2<accuracy>(ratio);
+    angle = selectSSE2(_mm_cmpgt_pd(imaginaryMagnitude, realMagnitude), _mm_sub_pd(_mm_set1_pd(M_PI_2), angle), angle);
+    angle = selectSSE2(signMaskSSE2(real), _mm_sub_pd(_mm_set1_pd(M_PI), angle), angle);
+    angle = _mm_or_pd(angle, _mm_and_pd(imaginary, signMask));
+    return selectSSE2(_mm_cmpunord_pd(real, imaginary), _mm_set1_pd(NAN), angle);
+}
+
+// Same results as ComplexNumber::modulus. Its fast path is taken per
+// vector, when every lane's sum of squares is usual, which is the same
+// way for all ordinary data; otherwise the usual lanes get a scale of one
+// and the rest are scaled without branching.
+inline __m128d hypotSSE2(__m128d real, __m128d imaginary) {
+    typedef ModulusScaling<double> Scaling;
+    __m128d sum = _mm_add_pd(_mm_mul_pd(real, real), _mm_mul_pd(imaginary, imaginary));
+    __m128d isUsual = _mm_and_pd(_mm_cmpge_pd(sum, _mm_set1_pd(Scaling::smallestSum)), _mm_cmple_pd(sum, _mm_set1_pd(DBL_MAX)));
+    if (_mm_movemask_pd(isUsual) == 0x3) {
+        return _mm_sqrt_pd(sum);
+    }
+
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d infinity = _mm_set1_pd(INFINITY);
+    __m128d realMagnitude = _mm_andnot_pd(signMask, real);
+    __m128d imaginaryMagnitude = _mm_andnot_pd(signMask, imaginary);
+    __m128d largest = _mm_max_pd(realMagnitude, imaginaryMagnitude);
+
+    __m128d isLarge = _mm_andnot_pd(isUsual, _mm_cmpgt_pd(largest, _mm_set1_pd(Scaling::upper)));
+    __m128d isSmall = _mm_andnot_pd(isUsual, _mm_cmplt_pd(largest, _mm_set1_pd(Scaling::lower)));
+    __m128d scale = selectSSE2(isLarge, _mm_set1_pd(Scaling::shrink), selectSSE2(isSmall, _mm_set1_pd(Scaling::grow), one));
+    __m128d inverse = selectSSE2(isLarge, _mm_set1_pd(Scaling::shrinkInverse), selectSSE2(isSmall, _mm_set1_pd(Scaling::growInverse), one));
+
+    __m128d scaledReal = _mm_mul_pd(real, scale);
+    __m128d scaledImaginary = _mm_mul_pd(imaginary, scale);
+    __m128d result = _mm_mul_pd(_mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(scaledReal, scaledReal), _mm_mul_pd(scaledImaginary, scaledImaginary))), inverse);
+    __m128d isInfinite = _mm_or_pd(_mm_cmpeq_pd(realMagnitude, infinity), _mm_cmpeq_pd(imaginaryMagnitude, infinity));
+    return selectSSE2(isInfinite, infinity, result);
+}
+
+void addSSE2(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count) {
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        _mm_storeu_pd(real + index, _mm_add_pd(_mm_loadu_pd(lhsReal + index), _mm_loadu_pd(rhsReal + index)));
+        _mm_storeu_pd(imaginary + index, _mm_add_pd(_mm_loadu_pd(lhsImaginary + index), _mm_loadu_pd(rhsImaginary + index)));
+    }
+    addScalar(lhsReal + index, lhsImaginary + index, rhsReal + index, rhsImaginary + index, real + index, imaginary + index, count - index);
+}
+
+void subtractSSE2(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count) {
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        _mm_storeu_pd(real + index, _mm_sub_pd(_mm_loadu_pd(lhsReal + index), _mm_loadu_pd(rhsReal + index)));
+        _mm_storeu_pd(imaginary + index, _mm_sub_pd(_mm_loadu_pd(lhsImaginary + index), _mm_loadu_pd(rhsImaginary + index)));
+    }
+    subtractScalar(lhsReal + index, lhsImaginary + index, rhsReal + index, rhsImaginary + index, real + index, imaginary + index, count - index);
+}
+
+void multiplySSE2(const double* lhsReal, const double* lhsImaginary, double factor, double* real, double* imaginary, size_t count) {
+    const __m128d factors = _mm_set1_pd(factor);
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        _mm_storeu_pd(real + index, _mm_mul_pd(_mm_loadu_pd(lhsReal + index), factors));
+        _mm_storeu_pd(imaginary + index, _mm_mul_pd(_mm_loadu_pd(lhsImaginary + index), factors));
+    }
+    multiplyScalar(lhsReal + index, lhsImaginary + index, factor, real + index, imaginary + index, count - index);
+}
+
+void divideSSE2(const double* lhsReal, const double* lhsImaginary, double divisor, double* real, double* imaginary, size_t count) {
+    const __m128d divisors = _mm_set1_pd(divisor);
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        _mm_storeu_pd(real + index, _mm_div_pd(_mm_loadu_pd(lhsReal + index), divisors));
+        _mm_storeu_pd(imaginary + index, _mm_div_pd(_mm_loadu_pd(lhsImaginary + index), divisors));
+    }
+    divideScalar(lhsReal + index, lhsImaginary + index, divisor, real + index, imaginary + index, count - index);
+}
+
+void modulusSSE2(const double* real, const double* imaginary, double* result, size_t count) {
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        _mm_storeu_pd(result + index, hypotSSE2(_mm_loadu_pd(real + index), _mm_loadu_pd(imaginary + index)));
+    }
+    modulusScalar(real + index, imaginary + index, result + index, count - index);
+}
+
+template <ArgumentAccuracy accuracy>
+void argumentSSE2(const double* real, const double* imaginary, double* result, size_t count) {
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        _mm_storeu_pd(result + index, atan2SSE2<accuracy>(_mm_loadu_pd(imaginary + index), _mm_loadu_pd(real + index)));
+    }
+    argumentScalar<accuracy>(real + index, imaginary + index, result + index, count - index);
+}
+
+void argumentSSE2(const double* real, const double* imaginary, double* result, size_t count, ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return argumentSSE2<ArgumentAccuracy::FULL>(real, imaginary, result, count);
+        case ArgumentAccuracy::FAST:
+            return argumentSSE2<ArgumentAccuracy::FAST>(real, imaginary, result, count);
+        case ArgumentAccuracy::COARSE:
+            return argumentSSE2<ArgumentAccuracy::COARSE>(real, imaginary, result, count);
+    }
+}
+
+// Two numbers per step: {re0, im0}, {re1, im1} unpacked into {re0, re1}
+// and {im0, im1}.
+void modulusInterleavedSSE2(const ComplexNumber* numbers, double* result, size_t count) {
+    const double* parts = reinterpret_cast<const double*>(numbers);
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        __m128d first = _mm_loadu_pd(parts + 2*index);
+        __m128d second = _mm_loadu_pd(parts + 2*index + 2);
+        _mm_storeu_pd(result + index, hypotSSE2(_mm_unpacklo_pd(first, second), _mm_unpackhi_pd(first, second)));
+    }
+    modulusInterleavedScalar(numbers + index, result + index, count - index);
+}
+
+template <ArgumentAccuracy accuracy>
+void argumentInterleavedSSE2(const ComplexNumber* numbers, double* result, size_t count) {
+    const double* parts = reinterpret_cast<const double*>(numbers);
+    size_t index = 0;
+    for (; index + 2 <= count; index += 2) {
+        __m128d first = _mm_loadu_pd(parts + 2*index);
+        __m128d second = _mm_loadu_pd(parts + 2*index + 2);
+        _mm_storeu_pd(result + index, atan2SSE2<accuracy>(_mm_unpackhi_pd(first, second), _mm_unpacklo_pd(first, second)));
+    }
+    argumentInterleavedScalar<accuracy>(numbers + index, result + index, count - index);
+}
+
+void argumentInterleavedSSE2(const ComplexNumber* numbers, double* result, size_t count, ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return argumentInterleavedSSE2<ArgumentAccuracy::FULL>(numbers, result, count);
+        case ArgumentAccuracy::FAST:
+            return argumentInterleavedSSE2<ArgumentAccuracy::FAST>(numbers, result, count);
+        case ArgumentAccuracy::COARSE:
+            return argumentInterleavedSSE2<ArgumentAccuracy::COARSE>(numbers, result, count);
+    }
+}
+
+const ComplexArrayKernels sse2Kernels = {
+    addSSE2,
+    subtractSSE2,
+    multiplySSE2,
+    divideSSE2,
+    modulusSSE2,
+    argumentSSE2,
+    modulusInterleavedSSE2,
+    argumentInterleavedSSE2
+};
+
+// MARK: - AVX2 Kernels
+
+template <size_t degree>
+COMPLEX_ARRAY_AVX2 inline __m256d atanPolynomialAVX2(const double (&coefficients)[degree], __m256d x) {
+    __m256d square = _mm256_mul_pd(x, x);
+    __m256d polynomial = _mm256_set1_pd(coefficients[0]);
+    for (size_t index = 1; index < degree; ++index) {
+        polynomial = _mm256_add_pd(_mm256_mul_pd(polynomial, square), _mm256_set1_pd(coefficients[index]));
+    }
+    return _mm256_mul_pd(x, polynomial);
+}
+
+template <ArgumentAccuracy accuracy>
+COMPLEX_ARRAY_AVX2 inline __m256d atanUnitAVX2(__m256d x) {
+    if constexpr (accuracy == ArgumentAccuracy::FULL) {
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d middle = _mm256_cmp_pd(x, _mm256_set1_pd(0.66), _CMP_GT_OQ);
+        __m256d reduced = _mm256_blendv_pd(x, _mm256_div_pd(_mm256_sub_pd(x, one), _mm256_add_pd(x, one)), middle);
+        __m256d offset = _mm256_blendv_pd(_mm256_setzero_pd(), _mm256_set1_pd(M_PI_4), middle);
+        __m256d moreBits = _mm256_blendv_pd(_mm256_setzero_pd(), _mm256_set1_pd(0.5 * atanMoreBits), middle);
+
+        __m256d square = _mm256_mul_pd(reduced, reduced);
+        __m256d numerator = _mm256_set1_pd(atanP[0]);
+        for (int index = 1; index < 5; ++index) {
+            numerator = _mm256_add_pd(_mm256_mul_pd(numerator, square), _mm256_set1_pd(atanP[index]));
+        }
+        __m256d denominator = _mm256_add_pd(square, _mm256_set1_pd(atanQ[0]));
+        for (int index = 1; index < 5; ++index) {
+            denominator = _mm256_add_pd(_mm256_mul_pd(denominator, square), _mm256_set1_pd(atanQ[index]));
+        }
+
+        __m256d tail = _mm256_div_pd(_mm256_mul_pd(square, numerator), denominator);
+        tail = _mm256_add_pd(_mm256_mul_pd(reduced, tail), reduced);
+        return _mm256_add_pd(offset, _mm256_add_pd(tail, moreBits));
+    } else if constexpr (accuracy == ArgumentAccuracy::FAST) {
+        return atanPolynomialAVX2(atanFast, x);
+    } else {
+        return atanPolynomialAVX2(atanCoarse, x);
+    }
+}
+
+// blendv only looks at the sign bit, so real itself selects the lanes
+// with a negative (or negative zero) real part.
+template <ArgumentAccuracy accuracy>
+COMPLEX_ARRAY_AVX2 inline __m256d atan2AVX2(__m256d imaginary, __m256d real) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d realMagnitude = _mm256_andnot_pd(signMask, real);
+    __m256d imaginaryMagnitude = _mm256_andnot_pd(signMask, imaginary);
+    __m256d largest = _mm256_max_pd(realMagnitude, imaginaryMagnitude);
+    __m256d smallest = _mm256_min_pd(realMagnitude, imaginaryMagnitude);
+
+    __m256d ratio = _mm256_div_pd(smallest, largest);
+    ratio = _mm256_blendv_pd(ratio, zero, _mm256_cmp_pd(largest, zero, _CMP_EQ_OQ));
+    ratio = _mm256_blendv_pd(ratio, _mm256_set1_pd(1.0), _mm256_cmp_pd(smallest, _mm256_set1_pd(INFINITY), _CMP_EQ_OQ));
+
+    __m256d angle = atanUnitAVX2<accuracy>(ratio);
+    angle = _mm256_blendv_pd(angle, _mm256_sub_pd(_mm256_set1_pd(M_PI_2), angle), _mm256_cmp_pd(imaginaryMagnitude, realMagnitude, _CMP_GT_OQ));
+    angle = _mm256_blendv_pd(angle, _mm256_sub_pd(_mm256_set1_pd(M_PI), angle), real);
+    angle = _mm256_or_pd(angle, _mm256_and_pd(imaginary, signMask));
+    return _mm256_blendv_pd(angle, _mm256_set1_pd(NAN), _mm256_cmp_pd(real, imaginary, _CMP_UNORD_Q));
+}
+
+// Same results as ComplexNumber::modulus, fast path as in hypotSSE2.
+COMPLEX_ARRAY_AVX2 inline __m256d hypotAVX2(__m256d real, __m256d imaginary) {
+    typedef ModulusScaling<double> Scaling;
+    __m256d sum = _mm256_add_pd(_mm256_mul_pd(real, real), _mm256_mul_pd(imaginary, imaginary));
+    __m256d isUsual = _mm256_and_pd(_mm256_cmp_pd(sum, _mm256_set1_pd(Scaling::smallestSum), _CMP_GE_OQ), _mm256_cmp_pd(sum, _mm256_set1_pd(DBL_MAX), _CMP_LE_OQ));
+    if (_mm256_movemask_pd(isUsual) == 0xF) {
+        return _mm256_sqrt_pd(sum);
+    }
+
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d infinity = _mm256_set1_pd(INFINITY);
+    __m256d realMagnitude = _mm256_andnot_pd(signMask, real);
+    __m256d imaginaryMagnitude = _mm256_andnot_pd(signMask, imaginary);
+    __m256d largest = _mm256_max_pd(realMagnitude, imaginaryMagnitude);
+
+    __m256d isLarge = _mm256_andnot_pd(isUsual, _mm256_cmp_pd(largest, _mm256_set1_pd(Scaling::upper), _CMP_GT_OQ));
+    __m256d isSmall = _mm256_andnot_pd(isUsual, _mm256_cmp_pd(largest, _mm256_set1_pd(Scaling::lower), _CMP_LT_OQ));
+    __m256d scale = _mm256_blendv_pd(_mm256_blendv_pd(one, _mm256_set1_pd(Scaling::grow), isSmall), _mm256_set1_pd(Scaling::shrink), isLarge);
+    __m256d inverse = _mm256_blendv_pd(_mm256_blendv_pd(one, _mm256_set1_pd(Scaling::growInverse), isSmall), _mm256_set1_pd(Scaling::shrinkInverse), isLarge);
+
+    __m256d scaledReal = _mm256_mul_pd(real, scale);
+    __m256d scaledImaginary = _mm256_mul_pd(imaginary, scale);
+    __m256d result = _mm256_mul_pd(_mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(scaledReal, scaledReal), _mm256_mul_pd(scaledImaginary, scaledImaginary))), inverse);
+    __m256d isInfinite = _mm256_or_pd(_mm256_cmp_pd(realMagnitude, infinity, _CMP_EQ_OQ), _mm256_cmp_pd(imaginaryMagnitude, infinity, _CMP_EQ_OQ));
+    return _mm256_blendv_pd(result, infinity, isInfinite);
+}
+
+COMPLEX_ARRAY_AVX2 void addAVX2(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count) {
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        _mm256_storeu_pd(real + index, _mm256_add_pd(_mm256_loadu_pd(lhsReal + index), _mm256_loadu_pd(rhsReal + index)));
+        _mm256_storeu_pd(imaginary + index, _mm256_add_pd(_mm256_loadu_pd(lhsImaginary + index), _mm256_loadu_pd(rhsImaginary + index)));
+    }
+    addScalar(lhsReal + index, lhsImaginary + index, rhsReal + index, rhsImaginary + index, real + index, imaginary + index, count - index);
+}
+
+COMPLEX_ARRAY_AVX2 void subtractAVX2(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count) {
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        _mm256_storeu_pd(real + index, _mm256_sub_pd(_mm256_loadu_pd(lhsReal + index), _mm256_loadu_pd(rhsReal + index)));
+        _mm256_storeu_pd(imaginary + index, _mm256_sub_pd(_mm256_loadu_pd(lhsImaginary + index), _mm256_loadu_pd(rhsImaginary + index)));
+    }
+    subtractScalar(lhsReal + index, lhsImaginary + index, rhsReal + index, rhsImaginary + index, real + index, imaginary + index, count - index);
+}
+
+COMPLEX_ARRAY_AVX2 void multiplyAVX2(const double* lhsReal, const double* lhsImaginary, double factor, double* real, double* imaginary, size_t count) {
+    const __m256d factors = _mm256_set1_pd(factor);
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        _mm256_storeu_pd(real + index, _mm256_mul_pd(_mm256_loadu_pd(lhsReal + index), factors));
+        _mm256_storeu_pd(imaginary + index, _mm256_mul_pd(_mm256_loadu_pd(lhsImaginary + index), factors));
+    }
+    multiplyScalar(lhsReal + index, lhsImaginary + index, factor, real + index, imaginary + index, count - index);
+}
+
+COMPLEX_ARRAY_AVX2 void divideAVX2(const double* lhsReal, const double* lhsImaginary, double divisor, double* real, double* imaginary, size_t count) {
+    const __m256d divisors = _mm256_set1_pd(divisor);
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        _mm256_storeu_pd(real + index, _mm256_div_pd(_mm256_loadu_pd(lhsReal + index), divisors));
+        _mm256_storeu_pd(imaginary + index, _mm256_div_pd(_mm256_loadu_pd(lhsImaginary + index), divisors));
+    }
+    divideScalar(lhsReal + index, lhsImaginary + index, divisor, real + index, imaginary + index, count - index);
+}
+
+COMPLEX_ARRAY_AVX2 void modulusAVX2(const double* real, const double* imaginary, double* result, size_t count) {
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        _mm256_storeu_pd(result + index, hypotAVX2(_mm256_loadu_pd(real + index), _mm256_loadu_pd(imaginary + index)));
+    }
+    modulusScalar(real + index, imaginary + index, result + index, count - index);
+}
+
+template <ArgumentAccuracy accuracy>
+COMPLEX_ARRAY_AVX2 void argumentAVX2(const double* real, const double* imaginary, double* result, size_t count) {
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        _mm256_storeu_pd(result + index, atan2AVX2<accuracy>(_mm256_loadu_pd(imaginary + index), _mm256_loadu_pd(real + index)));
+    }
+    argumentScalar<accuracy>(real + index, imaginary + index, result + index, count - index);
+}
+
+void argumentAVX2(const double* real, const double* imaginary, double* result, size_t count, ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return argumentAVX2<ArgumentAccuracy::FULL>(real, imaginary, result, count);
+        case ArgumentAccuracy::FAST:
+            return argumentAVX2<ArgumentAccuracy::FAST>(real, imaginary, result, count);
+        case ArgumentAccuracy::COARSE:
+            return argumentAVX2<ArgumentAccuracy::COARSE>(real, imaginary, result, count);
+    }
+}
+
+// Four numbers per step. Unpacking within 128-bit lanes gives the parts in
+// the order 0, 2, 1, 3, which the kernels don't care about; one permute
+// puts the results back in order.
+COMPLEX_ARRAY_AVX2 void modulusInterleavedAVX2(const ComplexNumber* numbers, double* result, size_t count) {
+    const double* parts = reinterpret_cast<const double*>(numbers);
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        __m256d first = _mm256_loadu_pd(parts + 2*index);
+        __m256d second = _mm256_loadu_pd(parts + 2*index + 4);
+        __m256d moduli = hypotAVX2(_mm256_unpacklo_pd(first, second), _mm256_unpackhi_pd(first, second));
+        _mm256_storeu_pd(result + index, _mm256_permute4x64_pd(moduli, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    modulusInterleavedScalar(numbers + index, result + index, count - index);
+}
+
+template <ArgumentAccuracy accuracy>
+COMPLEX_ARRAY_AVX2 void argumentInterleavedAVX2(const ComplexNumber* numbers, double* result, size_t count) {
+    const double* parts = reinterpret_cast<const double*>(numbers);
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        __m256d first = _mm256_loadu_pd(parts + 2*index);
+        __m256d second = _mm256_loadu_pd(parts + 2*index + 4);
+        __m256d angles = atan2AVX2<accuracy>(_mm256_unpackhi_pd(first, second), _mm256_unpacklo_pd(first, second));
+        _mm256_storeu_pd(result + index, _mm256_permute4x64_pd(angles, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    argumentInterleavedScalar<accuracy>(numbers + index, result + index, count - index);
+}
+
+void argumentInterleavedAVX2(const ComplexNumber* numbers, double* result, size_t count, ArgumentAccuracy accuracy) {
+    switch (accuracy) {
+        case ArgumentAccuracy::FULL:
+            return argumentInterleavedAVX2<ArgumentAccuracy::FULL>(numbers, result, count);
+        case ArgumentAccuracy::FAST:
+            return argumentInterleavedAVX2<ArgumentAccuracy::FAST>(numbers, result, count);
+        case ArgumentAccuracy::COARSE:
+            return argumentInterleavedAVX2<ArgumentAccuracy::COARSE>(numbers, result, count);
+    }
+}
+
+const ComplexArrayKernels avx2Kernels = {
+    addAVX2,
+    subtractAVX2,
+    multiplyAVX2,
+    divideAVX2,
+    modulusAVX2,
+    argumentAVX2,
+    modulusInterleavedAVX2,
+    argumentInterleavedAVX2
+};
+
+#endif
+
+// MARK: - Dispatch
+
+SimdLevel detectSimdLevel() {
+#if defined(COMPLEX_ARRAY_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(COMPLEX_ARRAY_X86)
+    return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel supportedSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+const ComplexArrayKernels& complexArrayKernels(SimdLevel level) {
+    if (level > supportedSimdLevel()) {
+        level = supportedSimdLevel();
+    }
+    switch (level) {
+#ifdef COMPLEX_ARRAY_X86
+        case SimdLevel::AVX2:
+            return avx2Kernels;
+        case SimdLevel::SSE2:
+            return sse2Kernels;
+#endif
+        default:
+            return scalarKernels;
+    }
+}
+
+// MARK: - Polar Functions
+
+void modulus(const ComplexNumber* numbers, double* result, size_t count, SimdLevel level) {
+    complexArrayKernels(level).modulusInterleaved(numbers, result, count);
+}
+
+void argument(const ComplexNumber* numbers, double* result, size_t count, ArgumentAccuracy accuracy, SimdLevel level) {
+    complexArrayKernels(level).argumentInterleaved(numbers, result, count, accuracy);
+}
+
+double argument(ComplexNumber number, ArgumentAccuracy accuracy) {
+    double result = 0;
+    argumentInterleavedScalar(&number, &result, 1, accuracy);
+    return result;
+}
+
+// MARK: - Complex Array
+
+ComplexArray::ComplexArray(const std::vector<ComplexNumber>& numbers): real(numbers.size()), imaginary(numbers.size()) {
+    for (size_t index = 0; index < numbers.size(); ++index) {
+        set(index, numbers[index]);
+    }
+}
+
+void ComplexArray::resize(size_t size) {
+    real.resize(size);
+    imaginary.resize(size);
+}
+
+void ComplexArray::reserve(size_t capacity) {
+    real.reserve(capacity);
+    imaginary.reserve(capacity);
+}
+
+void ComplexArray::push_back(ComplexNumber number) {
+    real.push_back(number.getReal());
+    imaginary.push_back(number.getImaginary());
+}
+
+void ComplexArray::set(size_t index, ComplexNumber number) {
+    real[index] = number.getReal();
+    imaginary[index] = number.getImaginary();
+}
+
+void ComplexArray::add(const ComplexArray& lhs, const ComplexArray& rhs, ComplexArray& result, SimdLevel level) {
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument("ComplexArray sizes differ");
+    }
+    result.resize(lhs.size());
+    complexArrayKernels(level).add(lhs.realData(), lhs.imaginaryData(), rhs.realData(), rhs.imaginaryData(), result.realData(), result.imaginaryData(), lhs.size());
+}
+
+void ComplexArray::subtract(const ComplexArray& lhs, const ComplexArray& rhs, ComplexArray& result, SimdLevel level) {
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument("ComplexArray sizes differ");
+    }
+    result.resize(lhs.size());
+    complexArrayKernels(level).subtract(lhs.realData(), lhs.imaginaryData(), rhs.realData(), rhs.imaginaryData(), result.realData(), result.imaginaryData(), lhs.size());
+}
+
+void ComplexArray::multiply(const ComplexArray& lhs, double factor, ComplexArray& result, SimdLevel level) {
+    result.resize(lhs.size());
+    complexArrayKernels(level).multiply(lhs.realData(), lhs.imaginaryData(), factor, result.realData(), result.imaginaryData(), lhs.size());
+}
+
+void ComplexArray::divide(const ComplexArray& lhs, double divisor, ComplexArray& result, SimdLevel level) {
+    result.resize(lhs.size());
+    complexArrayKernels(level).divide(lhs.realData(), lhs.imaginaryData(), divisor, result.realData(), result.imaginaryData(), lhs.size());
+}
+
+void ComplexArray::modulus(const ComplexArray& operand, AlignedBuffer& result, SimdLevel level) {
+    result.resize(operand.size());
+    complexArrayKernels(level).modulus(operand.realData(), operand.imaginaryData(), result.data(), operand.size());
+}
+
+void ComplexArray::argument(const ComplexArray& operand, AlignedBuffer& result, SimdLevel level) {
+    argument(operand, result, ArgumentAccuracy::FULL, level);
+}
+
+void ComplexArray::argument(const ComplexArray& operand, AlignedBuffer& result, ArgumentAccuracy accuracy, SimdLevel level) {
+    result.resize(operand.size());
+    complexArrayKernels(level).argument(operand.realData(), operand.imaginaryData(), result.data(), operand.size(), accuracy);
+}
+
+ComplexArray ComplexArray::operator+(const ComplexArray& secondTerm) const {
+    ComplexArray result;
+    add(*this, secondTerm, result);
+    return result;
+}
+
+ComplexArray ComplexArray::operator-(const ComplexArray& secondTerm) const {
+    ComplexArray result;
+    subtract(*this, secondTerm, result);
+    return result;
+}
+
+ComplexArray ComplexArray::operator*(const double factor) const {
+    ComplexArray result;
+    multiply(*this, factor, result);
+    return result;
+}
+
+ComplexArray ComplexArray::operator/(const double divisor) const {
+    ComplexArray result;
+    divide(*this, divisor, result);
+    return result;
+}
+
+AlignedBuffer ComplexArray::modulus() const {
+    AlignedBuffer result;
+    modulus(*this, result);
+    return result;
+}
+
+AlignedBuffer ComplexArray::argument() const {
+    AlignedBuffer result;
+    argument(*this, result);
+    return result;
+}
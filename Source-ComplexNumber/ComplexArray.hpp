@@ -0,0 +1,134 @@
+//
+//  ComplexArray.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef ComplexArray_hpp
+#define ComplexArray_hpp
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "ComplexNumber.hpp"
+
+// MARK: - Aligned Storage
+
+const size_t complexArrayAlignment = 64;
+
+template <typename T>
+struct AlignedAllocator {
+    typedef T value_type;
+
+    AlignedAllocator() {};
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {};
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(complexArrayAlignment)));
+    }
+
+    void deallocate(T* pointer, size_t) {
+        ::operator delete(pointer, std::align_val_t(complexArrayAlignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+typedef std::vector<double, AlignedAllocator<double>> AlignedBuffer;
+
+// MARK: - Kernels
+
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Highest level the running CPU supports, detected once, on the first call
+// from whichever thread; the kernel tables themselves are constant.
+SimdLevel supportedSimdLevel();
+
+// Bulk kernels over planar real/imaginary buffers, and over arrays of
+// ComplexNumber (interleaved parts). Every SIMD level gives the same results
+// as the scalar ComplexNumber methods:
+//   add, subtract, multiply, divide, modulus  bit exact (0 ULP), the same
+//                                             IEEE operations in the same order
+//   argument                                  bit exact at every accuracy
+//                                             (see ArgumentAccuracy); FULL is
+//                                             ComplexNumber::argument
+struct ComplexArrayKernels {
+    void (*add)(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count);
+    void (*subtract)(const double* lhsReal, const double* lhsImaginary, const double* rhsReal, const double* rhsImaginary, double* real, double* imaginary, size_t count);
+    void (*multiply)(const double* lhsReal, const double* lhsImaginary, double factor, double* real, double* imaginary, size_t count);
+    void (*divide)(const double* lhsReal, const double* lhsImaginary, double divisor, double* real, double* imaginary, size_t count);
+    void (*modulus)(const double* real, const double* imaginary, double* result, size_t count);
+    void (*argument)(const double* real, const double* imaginary, double* result, size_t count, ArgumentAccuracy accuracy);
+    void (*modulusInterleaved)(const ComplexNumber* numbers, double* result, size_t count);
+    void (*argumentInterleaved)(const ComplexNumber* numbers, double* result, size_t count, ArgumentAccuracy accuracy);
+};
+
+// Kernels for level, falling back to the best supported one below it.
+const ComplexArrayKernels& complexArrayKernels(SimdLevel level = supportedSimdLevel());
+
+// MARK: - Polar Functions
+
+// Batch modulus and argument of count numbers into result, for callers that
+// keep plain ComplexNumber arrays rather than a ComplexArray.
+void modulus(const ComplexNumber* numbers, double* result, size_t count, SimdLevel level = supportedSimdLevel());
+void argument(const ComplexNumber* numbers, double* result, size_t count, ArgumentAccuracy accuracy = ArgumentAccuracy::FULL, SimdLevel level = supportedSimdLevel());
+
+// A single argument at the given accuracy, the kernels' scalar path.
+double argument(ComplexNumber number, ArgumentAccuracy accuracy);
+
+// MARK: - Complex Array
+
+// Structure-of-arrays storage for many complex numbers: real and imaginary
+// parts live in separate 64-byte aligned buffers so the kernels can stream
+// over them with full-width vector loads.
+class ComplexArray {
+private:
+    AlignedBuffer real;
+    AlignedBuffer imaginary;
+public:
+    ComplexArray() {};
+    explicit ComplexArray(size_t size): real(size), imaginary(size) {};
+    ComplexArray(const std::vector<ComplexNumber>& numbers);
+
+    size_t size() const { return real.size(); }
+    void resize(size_t size);
+    void reserve(size_t capacity);
+    void push_back(ComplexNumber number);
+
+    ComplexNumber get(size_t index) const { return ComplexNumber(real[index], imaginary[index]); }
+    void set(size_t index, ComplexNumber number);
+
+    double* realData() { return real.data(); }
+    double* imaginaryData() { return imaginary.data(); }
+    const double* realData() const { return real.data(); }
+    const double* imaginaryData() const { return imaginary.data(); }
+
+    // Sizes of lhs and rhs must match, std::invalid_argument otherwise.
+    static void add(const ComplexArray& lhs, const ComplexArray& rhs, ComplexArray& result, SimdLevel level = supportedSimdLevel());
+    static void subtract(const ComplexArray& lhs, const ComplexArray& rhs, ComplexArray& result, SimdLevel level = supportedSimdLevel());
+    static void multiply(const ComplexArray& lhs, double factor, ComplexArray& result, SimdLevel level = supportedSimdLevel());
+    static void divide(const ComplexArray& lhs, double divisor, ComplexArray& result, SimdLevel level = supportedSimdLevel());
+    static void modulus(const ComplexArray& operand, AlignedBuffer& result, SimdLevel level = supportedSimdLevel());
+    static void argument(const ComplexArray& operand, AlignedBuffer& result, SimdLevel level = supportedSimdLevel());
+    static void argument(const ComplexArray& operand, AlignedBuffer& result, ArgumentAccuracy accuracy, SimdLevel level = supportedSimdLevel());
+
+    ComplexArray operator+(const ComplexArray& secondTerm) const;
+    ComplexArray operator-(const ComplexArray& secondTerm) const;
+    ComplexArray operator*(const double factor) const;
+    ComplexArray operator/(const double divisor) const;
+
+    AlignedBuffer modulus() const;
+    AlignedBuffer argument() const;
+};
+
+#endif /* ComplexArray_hpp */
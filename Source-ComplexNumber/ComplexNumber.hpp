@@ -9,7 +9,14 @@
 #define ComplexNumber_hpp
 
 #include <stdio.h>
+#include <charconv>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "PolarKernels.hpp"
 
 enum Operations {
     MODULUS,
@@ -22,50 +29,261 @@ enum Operations {
     INCREMENT,
 };
 
-class ComplexNumber {
+// Upper bounds for the shortest round-trip text of a scalar (long double
+// included, e.g. "-1.1897314953572317650e+4932") and of a complex number.
+constexpr size_t scalarCharsLength = 48;
+constexpr size_t complexNumberCharsLength = 2 * scalarCharsLength + 2;
+
+template <typename Scalar>
+std::string scalarToString(Scalar value) {
+    char buffer[scalarCharsLength];
+    auto result = std::to_chars(buffer, buffer + scalarCharsLength, value);
+    return std::string(buffer, result.ptr);
+}
+
+// Plain value type: two scalars, trivially copyable, everything inline.
+// All arithmetic is constexpr, so constant operands fold at compile time;
+// modulus and argument use <cmath> and are runtime only. Scalar is
+// the precision tier: float for bulk throughput, double by default, long
+// double for accuracy-critical paths.
+template <typename Scalar>
+class BasicComplexNumber {
+    static_assert(std::is_floating_point<Scalar>::value, "BasicComplexNumber needs a floating point scalar");
 private:
-    double real;
-    double imaginary;
+    Scalar real = 0;
+    Scalar imaginary = 0;
 public:
-    double getReal();
-    double getImaginary();
+    constexpr Scalar getReal() const noexcept { return real; }
+    constexpr Scalar getImaginary() const noexcept { return imaginary; }
+
+    constexpr BasicComplexNumber() noexcept = default;
+    constexpr BasicComplexNumber(const Scalar real, const Scalar imaginary) noexcept: real(real), imaginary(imaginary) {};
+    constexpr BasicComplexNumber(const Scalar real) noexcept: real(real), imaginary(0) {};
+
+    // MARK: - Special Math Operations For Complex Numbers
+
+    // hypot semantics at sqrt cost. The usual sum of squares takes the fast
+    // path, exactly sqrt(re*re + im*im); when it overflows or underflows,
+    // the parts are scaled by a power of two first (ModulusScaling). Within
+    // 1 ULP of std::hypot everywhere, and an infinite part gives infinity
+    // even when the other one is NaN.
+    Scalar modulus() const noexcept {
+        typedef ModulusScaling<Scalar> Scaling;
+        const Scalar sum = real*real + imaginary*imaginary;
+        if (sum >= Scaling::smallestSum && sum <= std::numeric_limits<Scalar>::max()) {
+            return std::sqrt(sum);
+        }
+
+        const Scalar infinity = std::numeric_limits<Scalar>::infinity();
+        const Scalar realMagnitude = std::fabs(real);
+        const Scalar imaginaryMagnitude = std::fabs(imaginary);
+        const Scalar largest = realMagnitude > imaginaryMagnitude ? realMagnitude : imaginaryMagnitude;
+
+        const bool isLarge = largest > Scaling::upper;
+        const bool isSmall = largest < Scaling::lower;
+        const Scalar scale = isLarge ? Scaling::shrink : (isSmall ? Scaling::grow : Scalar(1));
+        const Scalar inverse = isLarge ? Scaling::shrinkInverse : (isSmall ? Scaling::growInverse : Scalar(1));
+
+        const Scalar scaledReal = real*scale;
+        const Scalar scaledImaginary = imaginary*scale;
+        const Scalar result = std::sqrt(scaledReal*scaledReal + scaledImaginary*scaledImaginary)*inverse;
+        return realMagnitude == infinity || imaginaryMagnitude == infinity ? infinity : result;
+    }
+
+    // atan2 semantics: (-pi, pi], zero at the origin and signed zeros
+    // picking the side of the branch cut. Float and double use the
+    // branch-free FULL kernel in double, within 2 ULP of std::atan2; long
+    // double keeps std::atan2 for its extra digits. ComplexArray.hpp has
+    // batch and approximate versions.
+    Scalar argument() const noexcept {
+        if constexpr (std::is_same<Scalar, long double>::value) {
+            return std::atan2(imaginary, real);
+        } else {
+            return Scalar(atan2Scalar<ArgumentAccuracy::FULL>(imaginary, real));
+        }
+    }
+
+    // MARK: - Arithmetic Operations
+
+    constexpr BasicComplexNumber operator+(const BasicComplexNumber& secondTerm) const noexcept {
+        return BasicComplexNumber(real + secondTerm.real, imaginary + secondTerm.imaginary);
+    }
+
+    constexpr BasicComplexNumber operator-(const BasicComplexNumber& secondTerm) const noexcept {
+        return BasicComplexNumber(real - secondTerm.real, imaginary - secondTerm.imaginary);
+    }
+
+    constexpr BasicComplexNumber operator*(const BasicComplexNumber& factor) const noexcept {
+        return BasicComplexNumber(real*factor.real - imaginary*factor.imaginary, real*factor.imaginary + imaginary*factor.real);
+    }
+
+    // Smith's algorithm: scales by the larger part of the divisor so the
+    // intermediate products don't overflow or lose precision.
+    constexpr BasicComplexNumber operator/(const BasicComplexNumber& divisor) const noexcept {
+        const Scalar realMagnitude = divisor.real < 0 ? -divisor.real : divisor.real;
+        const Scalar imaginaryMagnitude = divisor.imaginary < 0 ? -divisor.imaginary : divisor.imaginary;
+
+        if (realMagnitude >= imaginaryMagnitude) {
+            const Scalar ratio = divisor.imaginary/divisor.real;
+            const Scalar denominator = divisor.real + divisor.imaginary*ratio;
+            return BasicComplexNumber((real + imaginary*ratio)/denominator, (imaginary - real*ratio)/denominator);
+        } else {
+            const Scalar ratio = divisor.real/divisor.imaginary;
+            const Scalar denominator = divisor.real*ratio + divisor.imaginary;
+            return BasicComplexNumber((real*ratio + imaginary)/denominator, (imaginary*ratio - real)/denominator);
+        }
+    }
+
+    constexpr BasicComplexNumber operator-() const noexcept {
+        return BasicComplexNumber(-real, -imaginary);
+    }
+
+    constexpr BasicComplexNumber& operator+=(const BasicComplexNumber& complex) noexcept {
+        return *this = *this + complex;
+    }
+
+    constexpr BasicComplexNumber& operator-=(const BasicComplexNumber& complex) noexcept {
+        return *this = *this - complex;
+    }
+
+    constexpr BasicComplexNumber& operator*=(const BasicComplexNumber& factor) noexcept {
+        return *this = *this * factor;
+    }
+
+    constexpr BasicComplexNumber& operator/=(const BasicComplexNumber& divisor) noexcept {
+        return *this = *this / divisor;
+    }
+
+    constexpr BasicComplexNumber operator++() noexcept {
+        real += 1;
+        imaginary += 1;
+
+        return BasicComplexNumber(real + 1, imaginary + 1);
+    }
+
+    constexpr BasicComplexNumber operator++(int) noexcept {
+        real += 1;
+        imaginary += 1;
 
-    ComplexNumber(const double real, const double imaginary);
-    ComplexNumber(const double real);
-    ComplexNumber(const ComplexNumber& complex);
+        return BasicComplexNumber(real, imaginary);
+    }
+
+    // MARK: - Additional Arithmetic Operations Supporting Scalar Type
+
+    friend constexpr BasicComplexNumber operator+(const BasicComplexNumber& complex, const Scalar real) noexcept {
+        return BasicComplexNumber(complex.real + real, complex.imaginary);
+    }
+
+    friend constexpr BasicComplexNumber operator-(const BasicComplexNumber& complex, const Scalar real) noexcept {
+        return BasicComplexNumber(complex.real - real, complex.imaginary);
+    }
+
+    friend constexpr BasicComplexNumber operator*(const BasicComplexNumber& complex, const Scalar real) noexcept {
+        return BasicComplexNumber(complex.real*real, complex.imaginary*real);
+    }
+
+    friend constexpr BasicComplexNumber operator/(const BasicComplexNumber& complex, const Scalar real) noexcept {
+        return BasicComplexNumber(complex.real/real, complex.imaginary/real);
+    }
+
+    constexpr BasicComplexNumber& operator+=(const Scalar real) noexcept {
+        return *this = *this + real;
+    }
+
+    constexpr BasicComplexNumber& operator-=(const Scalar real) noexcept {
+        return *this = *this - real;
+    }
+
+    constexpr BasicComplexNumber& operator*=(const Scalar real) noexcept {
+        return *this = *this * real;
+    }
+
+    constexpr BasicComplexNumber& operator/=(const Scalar real) noexcept {
+        return *this = *this / real;
+    }
 
-    double modulus();
-    double argument();
+    // MARK: - Logic Operation
 
-    friend ComplexNumber operator+(const ComplexNumber complex, const double real);
-    friend ComplexNumber operator-(const ComplexNumber complex, const double real);
-    friend ComplexNumber operator*(const ComplexNumber complex, const double real);
-    friend ComplexNumber operator/(const ComplexNumber complex, const double real);
+    constexpr bool operator==(const BasicComplexNumber& secondOperand) const noexcept {
+        return real == secondOperand.real && imaginary == secondOperand.imaginary;
+    }
+
+    constexpr bool operator!=(const BasicComplexNumber& secondOperand) const noexcept {
+        return !(*this == secondOperand);
+    }
+
+    // MARK: - Implicit Coercion from Integer And Scalar
+
+    constexpr BasicComplexNumber& operator=(const int realInteger) noexcept {
+        real = realInteger;
+        imaginary = 0;
+
+        return *this;
+    }
+
+    constexpr BasicComplexNumber& operator=(const Scalar realFloating) noexcept {
+        real = realFloating;
+        imaginary = 0;
+
+        return *this;
+    }
 
-    void operator+=(const ComplexNumber complex);
-    void operator-=(ComplexNumber complex);
-    ComplexNumber operator+(const ComplexNumber secondTerm);
-    ComplexNumber operator-(const ComplexNumber secondTerm);
+    // MARK: - Coercion To Scalar
 
-    bool operator==(const ComplexNumber secondOperand);
+    constexpr operator Scalar() const noexcept {
+        return real;
+    }
 
-    ComplexNumber operator++();
-    ComplexNumber operator++(int);
+    // MARK: - I/O Operations
 
-    friend std::ostream & operator << (std::ostream &out, const ComplexNumber &complex);
-    friend std::istream & operator >> (std::istream &in,  ComplexNumber &complex);
+    friend std::istream & operator >> (std::istream &in, BasicComplexNumber &complex) {
+        std::cout << "Enter Real Part ";
+        in >> complex.real;
+        std::cout << "Enter Imaginary Part ";
+        in >> complex.imaginary;
 
-    ComplexNumber& operator=(const int realInteger);
-    ComplexNumber& operator=(const double realFloating);
+        return in;
+    }
 
-    operator double();
+    friend std::ostream & operator << (std::ostream &out, const BasicComplexNumber &complex) {
+        out << complex.real;
+        out << "+i" << complex.imaginary << std::endl;
+
+        return out;
+    }
 
-    std::string to_string() {
-        auto imaginaryString = (imaginary < 0) ? std::to_string(imaginary).substr(1) : std::to_string(imaginary);
-        auto imaginaryPart = (imaginary < 0) ? "-i" : "+i";
+    // Writes "<real>+i<imaginary>" (or "-i") in the shortest form that
+    // reads back to the same values and, like std::to_chars, reports the end
+    // or value_too_large. complexNumberCharsLength bytes always suffice.
+    std::to_chars_result to_chars(char* first, char* last) const noexcept {
+        auto result = std::to_chars(first, last, real);
+        if (result.ec != std::errc()) {
+            return result;
+        }
+        if (last - result.ptr < 2) {
+            return {last, std::errc::value_too_large};
+        }
 
-        return std::to_string(real) + imaginaryPart + imaginaryString;
+        const bool isNegative = imaginary < 0;
+        *result.ptr++ = isNegative ? '-' : '+';
+        *result.ptr++ = 'i';
+        return std::to_chars(result.ptr, last, isNegative ? -imaginary : imaginary + Scalar(0));
+    }
+
+    std::string to_string() const {
+        char buffer[complexNumberCharsLength];
+        auto result = to_chars(buffer, buffer + complexNumberCharsLength);
+        return std::string(buffer, result.ptr);
     }
 };
 
+typedef BasicComplexNumber<float> ComplexNumberFloat;
+typedef BasicComplexNumber<double> ComplexNumber;
+typedef BasicComplexNumber<long double> ComplexNumberLongDouble;
+
+static_assert(std::is_trivially_copyable<ComplexNumber>::value, "ComplexNumber must stay a plain pair of doubles");
+static_assert(sizeof(ComplexNumber) == 2 * sizeof(double), "ComplexNumber must stay a plain pair of doubles");
+static_assert(sizeof(ComplexNumberFloat) == 2 * sizeof(float), "ComplexNumberFloat must stay a plain pair of floats");
+static_assert((ComplexNumber(1, 2) * ComplexNumber(3, -1)) == ComplexNumber(5, 5), "complex multiplication folds at compile time");
+
 #endif /* ComplexNumber_hpp */
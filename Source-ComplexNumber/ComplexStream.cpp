@@ -0,0 +1,181 @@
+//
+//  ComplexStream.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "ComplexStream.hpp"
+
+const char complexStreamMagic[4] = {'C', 'P', 'X', 'N'};
+const uint16_t complexStreamVersion = 1;
+
+// Numbers are buffered up to this many bytes before a write.
+const size_t complexStreamBlock = 1 << 16;
+
+// MARK: - Writing
+
+void appendComplexStreamHeader(std::string& output, ComplexLayout layout, uint64_t count) {
+    auto size = output.size();
+    output.resize(size + complexStreamHeaderSize, '\0');
+    auto header = &output[size];
+    std::memcpy(header, complexStreamMagic, sizeof(complexStreamMagic));
+    header[4] = static_cast<char>(complexStreamVersion & 0xFF);
+    header[5] = static_cast<char>(complexStreamVersion >> 8);
+    header[6] = static_cast<char>(layout);
+    header[7] = static_cast<char>(sizeof(double));
+    for (size_t byte = 0; byte < sizeof(count); ++byte) {
+        header[8 + byte] = static_cast<char>((count >> (8 * byte)) & 0xFF);
+    }
+}
+
+ComplexStreamWriter::ComplexStreamWriter(std::ostream& output, uint64_t count): output(output) {
+    buffer.reserve(complexStreamBlock + complexStreamHeaderSize);
+    appendComplexStreamHeader(buffer, ComplexLayout::INTERLEAVED, count);
+}
+
+ComplexStreamWriter::~ComplexStreamWriter() {
+    flush();
+}
+
+void ComplexStreamWriter::write(ComplexNumber number) {
+    appendComplexRecord(buffer, number);
+    if (buffer.size() >= complexStreamBlock) {
+        flush();
+    }
+}
+
+// On a little-endian host the numbers already are the records, so a run
+// of them skips the buffer.
+void ComplexStreamWriter::write(const ComplexNumber* numbers, size_t count) {
+    if constexpr (isLittleEndianHost) {
+        output.write(buffer.data(), buffer.size());
+        buffer.clear();
+        output.write(reinterpret_cast<const char*>(numbers), count * sizeof(ComplexNumber));
+    } else {
+        for (size_t index = 0; index < count; ++index) {
+            write(numbers[index]);
+        }
+    }
+}
+
+void ComplexStreamWriter::flush() {
+    output.write(buffer.data(), buffer.size());
+    buffer.clear();
+    output.flush();
+}
+
+// Writes count parts from data, swapping them through a buffer if needed.
+void writeParts(std::ostream& output, const double* data, size_t count) {
+    if constexpr (isLittleEndianHost) {
+        output.write(reinterpret_cast<const char*>(data), count * sizeof(double));
+    } else {
+        std::string buffer;
+        for (size_t first = 0; first < count; first += complexStreamBlock / sizeof(double)) {
+            size_t last = std::min(count, first + complexStreamBlock / sizeof(double));
+            buffer.resize((last - first) * sizeof(double));
+            for (size_t index = first; index < last; ++index) {
+                storeLittleEndian(&buffer[(index - first) * sizeof(double)], data[index]);
+            }
+            output.write(buffer.data(), buffer.size());
+        }
+    }
+}
+
+void writeComplexStream(std::ostream& output, const ComplexArray& numbers, ComplexLayout layout) {
+    if (layout == ComplexLayout::INTERLEAVED) {
+        ComplexStreamWriter writer (output, numbers.size());
+        for (size_t index = 0; index < numbers.size(); ++index) {
+            writer.write(numbers.get(index));
+        }
+        return;
+    }
+
+    std::string header;
+    appendComplexStreamHeader(header, ComplexLayout::PLANAR, numbers.size());
+    output.write(header.data(), header.size());
+    writeParts(output, numbers.realData(), numbers.size());
+    writeParts(output, numbers.imaginaryData(), numbers.size());
+    output.flush();
+}
+
+// MARK: - Reading
+
+Result<ComplexStreamView> ComplexStreamView::parse(std::string_view bytes) {
+    if (bytes.size() < complexStreamHeaderSize || std::memcmp(bytes.data(), complexStreamMagic, sizeof(complexStreamMagic)) != 0) {
+        return Result<ComplexStreamView>(Error("not a complex stream"));
+    }
+    auto header = reinterpret_cast<const unsigned char*>(bytes.data());
+    auto version = static_cast<uint16_t>(header[4] | header[5] << 8);
+    if (version != complexStreamVersion) {
+        return Result<ComplexStreamView>(Error("unsupported complex stream version " + std::to_string(version)));
+    }
+    if (header[6] > static_cast<unsigned char>(ComplexLayout::PLANAR)) {
+        return Result<ComplexStreamView>(Error("unknown complex stream layout " + std::to_string(header[6])));
+    }
+    if (header[7] != sizeof(double)) {
+        return Result<ComplexStreamView>(Error("complex stream parts of " + std::to_string(header[7]) + " bytes, only doubles are read"));
+    }
+    auto layout = static_cast<ComplexLayout>(header[6]);
+    uint64_t count = 0;
+    for (size_t byte = 0; byte < sizeof(count); ++byte) {
+        count |= static_cast<uint64_t>(header[8 + byte]) << (8 * byte);
+    }
+
+    auto data = bytes.substr(complexStreamHeaderSize);
+    if (reinterpret_cast<uintptr_t>(data.data()) % alignof(double) != 0) {
+        return Result<ComplexStreamView>(Error("complex stream data is not aligned for double"));
+    }
+    const size_t numberSize = 2 * sizeof(double);
+    if (count == unknownComplexCount) {
+        if (layout != ComplexLayout::INTERLEAVED) {
+            return Result<ComplexStreamView>(Error("planar complex stream without a count"));
+        }
+        if (data.size() % numberSize != 0) {
+            return Result<ComplexStreamView>(Error("complex stream ends inside a number", bytes.size() - data.size() % numberSize));
+        }
+        count = data.size() / numberSize;
+    } else if (count > data.size() / numberSize || count * numberSize != data.size()) {
+        return Result<ComplexStreamView>(Error("complex stream of " + std::to_string(count) + " numbers has " + std::to_string(data.size()) + " bytes of data"));
+    }
+    return Result<ComplexStreamView>(ComplexStreamView(data.data(), count, layout));
+}
+
+const ComplexNumber* ComplexStreamView::interleavedData() const {
+    if (!isLittleEndianHost || layout != ComplexLayout::INTERLEAVED) {
+        return nullptr;
+    }
+    return reinterpret_cast<const ComplexNumber*>(data);
+}
+
+const double* ComplexStreamView::realData() const {
+    if (!isLittleEndianHost || layout != ComplexLayout::PLANAR) {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(data);
+}
+
+const double* ComplexStreamView::imaginaryData() const {
+    auto real = realData();
+    return real == nullptr ? nullptr : real + count;
+}
+
+ComplexArray ComplexStreamView::toArray() const {
+    ComplexArray numbers (count);
+    if (realData() != nullptr && count > 0) {
+        std::memcpy(numbers.realData(), realData(), count * sizeof(double));
+        std::memcpy(numbers.imaginaryData(), imaginaryData(), count * sizeof(double));
+        return numbers;
+    }
+    for (size_t index = 0; index < count; ++index) {
+        auto number = (*this)[index];
+        numbers.realData()[index] = number.getReal();
+        numbers.imaginaryData()[index] = number.getImaginary();
+    }
+    return numbers;
+}
@@ -0,0 +1,156 @@
+//
+//  ComplexStream.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef ComplexStream_hpp
+#define ComplexStream_hpp
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "ComplexArray.hpp"
+#include "ComplexNumber.hpp"
+#include "Result.hpp"
+
+// Binary exchange format for many complex numbers, exact and about a
+// tenth the size of the text and the cost of parsing it. Everything is
+// little-endian:
+//   offset  0  "CPXN"
+//           4  uint16  version, 1
+//           6  uint8   layout, ComplexLayout
+//           7  uint8   bytes per part, 8: parts are IEEE doubles
+//           8  uint64  count, or unknownComplexCount
+//          16  zero, up to complexStreamHeaderSize
+//          64  the numbers
+// INTERLEAVED data is count (real, imaginary) pairs, as ComplexNumber
+// lies in memory; PLANAR data is count reals, then count imaginaries, as
+// ComplexArray keeps them. An unknown count, for a writer that streams
+// its numbers out before it knows how many there are, means pairs up to
+// the end of the data and only goes with INTERLEAVED.
+// The header is 64 bytes so that, in a mapped file, the data is as
+// aligned as ComplexArray's buffers.
+enum class ComplexLayout: uint8_t {
+    INTERLEAVED,
+    PLANAR
+};
+
+const size_t complexStreamHeaderSize = 64;
+const uint64_t unknownComplexCount = UINT64_MAX;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool isLittleEndianHost = false;
+#else
+constexpr bool isLittleEndianHost = true;
+#endif
+
+inline uint64_t byteSwapped(uint64_t value) {
+    value = ((value & 0x00FF00FF00FF00FFull) << 8) | ((value >> 8) & 0x00FF00FF00FF00FFull);
+    value = ((value & 0x0000FFFF0000FFFFull) << 16) | ((value >> 16) & 0x0000FFFF0000FFFFull);
+    return (value << 32) | (value >> 32);
+}
+
+// A double to or from its little-endian bytes.
+inline void storeLittleEndian(char* bytes, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if constexpr (!isLittleEndianHost) {
+        bits = byteSwapped(bits);
+    }
+    std::memcpy(bytes, &bits, sizeof(bits));
+}
+
+inline double loadLittleEndian(const char* bytes) {
+    uint64_t bits;
+    std::memcpy(&bits, bytes, sizeof(bits));
+    if constexpr (!isLittleEndianHost) {
+        bits = byteSwapped(bits);
+    }
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// MARK: - Writing
+
+void appendComplexStreamHeader(std::string& output, ComplexLayout layout, uint64_t count);
+
+// One INTERLEAVED number; the header must come first.
+inline void appendComplexRecord(std::string& output, ComplexNumber number) {
+    auto size = output.size();
+    output.resize(size + 2 * sizeof(double));
+    storeLittleEndian(&output[size], number.getReal());
+    storeLittleEndian(&output[size + sizeof(double)], number.getImaginary());
+}
+
+// Streams INTERLEAVED numbers to output through a buffer, which goes out
+// whenever it fills and on flush() or destruction. count goes into the
+// header; leave it unknown when the writer can't tell in advance.
+class ComplexStreamWriter {
+private:
+    std::ostream& output;
+    std::string buffer;
+public:
+    explicit ComplexStreamWriter(std::ostream& output, uint64_t count = unknownComplexCount);
+    ~ComplexStreamWriter();
+
+    ComplexStreamWriter(const ComplexStreamWriter&) = delete;
+    ComplexStreamWriter& operator=(const ComplexStreamWriter&) = delete;
+
+    void write(ComplexNumber number);
+    void write(const ComplexNumber* numbers, size_t count);
+    void flush();
+};
+
+// A whole array with its count known, written straight from its buffers
+// when the layout is PLANAR.
+void writeComplexStream(std::ostream& output, const ComplexArray& numbers, ComplexLayout layout = ComplexLayout::PLANAR);
+
+// MARK: - Reading
+
+// The numbers of a complex stream in memory, e.g. MappedFile::contents(),
+// read in place: nothing is copied, and a number is only decoded when it
+// is asked for. Views into the bytes, which must outlive it.
+class ComplexStreamView {
+private:
+    const char* data = nullptr;
+    size_t count = 0;
+    ComplexLayout layout = ComplexLayout::INTERLEAVED;
+
+    ComplexStreamView(const char* data, size_t count, ComplexLayout layout): data(data), count(count), layout(layout) {};
+public:
+    ComplexStreamView() {};
+
+    // Checks the header and that the data holds count numbers exactly.
+    // The data must be aligned for double, as any mapping or heap buffer
+    // is.
+    static Result<ComplexStreamView> parse(std::string_view bytes);
+
+    size_t size() const { return count; }
+    ComplexLayout getLayout() const { return layout; }
+
+    ComplexNumber operator[](size_t index) const {
+        if (layout == ComplexLayout::INTERLEAVED) {
+            auto pair = data + 2 * sizeof(double) * index;
+            return ComplexNumber(loadLittleEndian(pair), loadLittleEndian(pair + sizeof(double)));
+        }
+        return ComplexNumber(loadLittleEndian(data + sizeof(double) * index), loadLittleEndian(data + sizeof(double) * (count + index)));
+    }
+
+    // The data as it lies, for kernels that take it directly; null when
+    // the layout is the other one or the host isn't little-endian.
+    const ComplexNumber* interleavedData() const;
+    const double* realData() const;
+    const double* imaginaryData() const;
+
+    // A copy in ComplexArray's aligned buffers, one memcpy per part when
+    // the data is PLANAR.
+    ComplexArray toArray() const;
+};
+
+#endif /* ComplexStream_hpp */
@@ -8,129 +8,213 @@
 #ifndef Console_hpp
 #define Console_hpp
 
-#include <vector>
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <variant>
-#include <optional>
 
 #include "ComplexNumber.hpp"
 #include "Tokenizer.hpp"
 #include "Flow.hpp"
 #include "FlowProcessor.hpp"
 #include "Calculator.hpp"
+#include "Instrumentation.hpp"
+#include "RequestArena.hpp"
 
-struct StateInfo {
-    virtual std::string getInfo() = 0;
-};
+// MARK: - Prompts
 
-const std::string greeting = "Hey, this is binary calculator working with complex numbers";
-const std::string realGrammarInfo = "The real part of complex number is an integer value";
-const std::string imaginaryGrammarInfo = "The imaginary part of complex number is an \"i\" letter following by integer value";
-const std::string examplesInfo = "Examples: \"2+i2\", \"-i2 -2.222\", \"2.222\", \"-i1.2\"";
-const std::string binaryOperationInfo = "You can type these operations: \"+\", \"-\", \"*\", \"/\"";
-const std::string methodInfo = "You can type these methods: \"modulus\", \"arg\"";
-const std::string resultInfo = "Your result: ";
+// The parts joined into one string at compile time.
+template <const std::string_view&... Parts>
+struct JoinedText {
+private:
+    static constexpr auto storage = [] {
+        std::array<char, (Parts.size() + ... + 0) + 1> characters {};
+        size_t size = 0;
+        for (std::string_view part: {Parts...}) {
+            for (char character: part) {
+                characters[size++] = character;
+            }
+        }
+        return characters;
+    }();
+public:
+    static constexpr std::string_view value {storage.data(), storage.size() - 1};
+};
 
-std::string makeOperandInfo() {
-    return realGrammarInfo + "\n" + imaginaryGrammarInfo + "\n" + examplesInfo + "\n" + "Type complex number: ";
-}
+inline constexpr std::string_view newline = "\n";
+inline constexpr std::string_view greeting = "Hey, this is binary calculator working with complex numbers";
+inline constexpr std::string_view realGrammarInfo = "The real part of complex number is an integer value";
+inline constexpr std::string_view imaginaryGrammarInfo = "The imaginary part of complex number is an \"i\" letter following by integer value";
+inline constexpr std::string_view examplesInfo = "Examples: \"2+i2\", \"-i2 -2.222\", \"2.222\", \"-i1.2\"";
+inline constexpr std::string_view operandRequest = "Type complex number: ";
+inline constexpr std::string_view binaryOperationInfo = "You can type these operations: \"+\", \"-\", \"*\", \"/\"";
+inline constexpr std::string_view methodInfo = "You can type these methods: \"modulus\", \"arg\", \"power\", \"root\", \"exp\", \"log\"";
+inline constexpr std::string_view operationRequest = "Type in order to go on the flow: ";
+inline constexpr std::string_view resultInfo = "Your result: ";
+inline constexpr std::string_view errorInfo = "Error:";
+inline constexpr std::string_view menuInfo = "Menu:\n A - Exit\n B - First operand\n Type: ";
+
+inline constexpr std::string_view menuPrompt = JoinedText<newline, menuInfo, newline>::value;
+inline constexpr std::string_view idlePrompt = JoinedText<greeting, menuPrompt>::value;
+inline constexpr std::string_view operandPrompt = JoinedText<realGrammarInfo, newline, imaginaryGrammarInfo, newline, examplesInfo, newline, operandRequest>::value;
+inline constexpr std::string_view operatorPrompt = JoinedText<binaryOperationInfo, newline, methodInfo, newline, operationRequest>::value;
+inline constexpr std::string_view doubleOperandPrompt = "You chose operation which second operand should be double.\nPlease, type double number: ";
+inline constexpr std::string_view exponentPrompt = "Please, type the exponent: ";
+inline constexpr std::string_view degreePrompt = "Please, type the degree of the root: ";
+inline constexpr std::string_view endPrompt = "Bye\n";
+
+// MARK: - States
+
+// Every state says which flow its next line is read as (Input), writes
+// its prompt and, from what the line parsed to, picks the next state. A
+// failed parse always leads to ErrorResult, so next() only sees values.
+// States whose prompt doesn't depend on their data write a precomputed one.
+template <const std::string_view& Prompt>
+struct FixedPrompt {
+    void write(std::string& output) const {
+        output.append(Prompt);
+    }
+};
 
-std::string getMenu(std::string target) {
-    return "Menu:\n A - Exit\n B - " + target + "\n Type: ";
-}
+struct ConsoleTransition;
 
-struct Idle: StateInfo {
-    std::string getInfo() override {
-        return greeting + "\n" + getMenu("First operand") + "\n";
-    }
+// The states ending a calculation, where the next line picks a menu item.
+struct MenuTransition {
+    typedef Menu Input;
+    ConsoleTransition next(MenuItems item) const;
 };
 
-struct FirstOperand: StateInfo {
-    std::string getInfo() override {
-        return makeOperandInfo();
-    }
+struct Idle: FixedPrompt<idlePrompt>, MenuTransition {};
+
+struct FirstOperand: FixedPrompt<operandPrompt> {
+    typedef ComplexOperand Input;
+    ConsoleTransition next(const ComplexNumber& operand) const;
 };
-struct Operator: StateInfo {
+
+struct Operator: FixedPrompt<operatorPrompt> {
+    typedef Operation Input;
     ComplexNumber firstOperand;
     Operator(ComplexNumber firstOperand): firstOperand(firstOperand) {};
 
-    std::string getInfo() override {
-        return binaryOperationInfo + "\n" + methodInfo + "\n" + "Type in order to go on the flow: ";
-    }
+    ConsoleTransition next(const OperationType& operation) const;
+};
+
+struct SecondOperand: FixedPrompt<operandPrompt> {
+    typedef ComplexOperand Input;
+    ComplexNumber firstOperand;
+    BinaryComplexOperation operation;
+
+    SecondOperand(ComplexNumber firstOperand, BinaryComplexOperation operation): firstOperand(firstOperand), operation(operation) {};
+
+    ConsoleTransition next(const ComplexNumber& secondOperand) const;
 };
 
-struct SecondDoubleOperand: StateInfo {
+struct SecondDoubleOperand: FixedPrompt<doubleOperandPrompt> {
+    typedef DoubleOperand Input;
     ComplexNumber firstOperand;
     BinaryComplexDoubleOperation operation;
 
     SecondDoubleOperand(ComplexNumber firstOperand, BinaryComplexDoubleOperation operation): firstOperand(firstOperand), operation(operation) {};
 
-    std::string getInfo() override {
-        return "You chose operation which second operand should be double.\nPlease, type double number: ";
-    }
+    ConsoleTransition next(double secondOperand) const;
 };
 
-struct SecondOperand: StateInfo {
-    ComplexNumber firstOperand;
-    BinaryComplexOperation operation;
+struct Exponent {
+    typedef DoubleOperand Input;
+    ComplexNumber operand;
+    Function method;
 
-    SecondOperand(ComplexNumber firstOperand, BinaryComplexOperation operation): firstOperand(firstOperand), operation(operation) {};
+    Exponent(ComplexNumber operand, Function method): operand(operand), method(method) {};
 
-    std::string getInfo() override {
-        return makeOperandInfo();
+    void write(std::string& output) const {
+        output.append(method == Function::ROOT ? degreePrompt : exponentPrompt);
     }
+
+    ConsoleTransition next(double exponent) const;
 };
 
-struct MethodResult: StateInfo {
+// Appends "Your result: <value>" and the menu, the value formatted in
+// place like everywhere else.
+template <typename Value>
+void writeResult(std::string& output, const Value& value) {
+    output.append(resultInfo);
+    auto size = output.size();
+    output.resize(size + complexNumberCharsLength);
+    auto first = &output[size];
+    auto last = first + complexNumberCharsLength;
+    if constexpr (std::is_floating_point<Value>::value) {
+        output.resize(std::to_chars(first, last, value).ptr - output.data());
+    } else {
+        output.resize(value.to_chars(first, last).ptr - output.data());
+    }
+    output.append(menuPrompt);
+}
+
+struct MethodResult: MenuTransition {
     ComplexNumber operand;
     Function method;
-    MethodResult(ComplexNumber operand, Function method): operand(operand), method(method) {};
+    double exponent;
+    MethodResult(ComplexNumber operand, Function method, double exponent = 0): operand(operand), method(method), exponent(exponent) {};
 
-    std::string getInfo() override {
-        auto result = Calculator::calculate(operand, method);
-        return resultInfo + std::to_string(result) + "\n" + getMenu("First operand") + "\n";
+    void write(std::string& output) const {
+        if (isRealValued(method)) {
+            writeResult(output, Calculator::calculate(operand, method));
+        } else {
+            writeResult(output, Calculator::calculate(std::make_pair(operand, exponent), method));
+        }
     }
 };
 
 typedef std::pair<ComplexNumber, ComplexNumber> ComplexOperands;
 
-struct BinaryComplexResult: StateInfo {
+struct BinaryComplexResult: MenuTransition {
     ComplexOperands operands;
     BinaryComplexOperation operation;
 
     BinaryComplexResult(ComplexOperands operands, BinaryComplexOperation operation): operands(operands), operation(operation) {};
 
-    std::string getInfo() override {
-        auto result = Calculator::calculate(operands, operation).to_string();
-        return resultInfo + result + "\n" + getMenu("First operand") + "\n";
+    void write(std::string& output) const {
+        writeResult(output, Calculator::calculate(operands, operation));
     }
 };
 
 typedef std::pair<ComplexNumber, double> MixedOperands;
 
-struct BinaryComplexDoubleResult: StateInfo {
+struct BinaryComplexDoubleResult: MenuTransition {
     MixedOperands operands;
     BinaryComplexDoubleOperation operation;
 
     BinaryComplexDoubleResult(MixedOperands operands, BinaryComplexDoubleOperation operation): operands(operands), operation(operation) {};
 
-    std::string getInfo() override {
-        auto result = Calculator::calculate(operands, operation).to_string();
-        return resultInfo + result + "\n" + getMenu("First operand") + "\n";
+    void write(std::string& output) const {
+        writeResult(output, Calculator::calculate(operands, operation));
     }
 };
 
-struct ErrorResult: StateInfo {
+struct ErrorResult: MenuTransition {
     std::string description;
-    ErrorResult(std::string description): description(description) {};
+    ErrorResult(std::string description): description(std::move(description)) {};
+    ErrorResult(const Error& error): description("Invalid Input: ") {
+        description += error.description;
+        if (error.position.has_value()) {
+            description += " at column ";
+            description += std::to_string(error.position.value() + 1);
+        }
+    };
 
-    std::string getInfo() override {
-        return "Error:" + description + "\n" + getMenu("First operand") + "\n";
+    void write(std::string& output) const {
+        output.append(errorInfo);
+        output.append(description);
+        output.append(menuPrompt);
     }
 };
-struct End: StateInfo {
-    std::string getInfo() override {
-        return "Bye\n";
-    }
+
+struct End: FixedPrompt<endPrompt> {
+    typedef Menu Input;
+    ConsoleTransition next(MenuItems) const;
 };
 
 typedef std::variant<
@@ -139,6 +223,7 @@ typedef std::variant<
     Operator,
     SecondOperand,
     SecondDoubleOperand,
+    Exponent,
     MethodResult,
     BinaryComplexResult,
     BinaryComplexDoubleResult,
@@ -146,165 +231,130 @@ typedef std::variant<
     End
 > ConsoleState;
 
-struct NewTokensEvent {
-    std::vector<Token> tokens;
-    FlowProcessor processor = FlowProcessor();
-
-    NewTokensEvent(std::vector<Token>& tokens): tokens(tokens) {};
-
-    ConsoleState operator()(const Idle&) {
-        Flow<Menu> flowItem (tokens);
-        std::optional<MenuItems> menuItem = processor.process(flowItem).success();
-
-        if (menuItem.has_value()) {
-            switch (menuItem.value()) {
-                case MenuItems::EXIT:
-                    return End();
-                case MenuItems::TARGET:
-                    return FirstOperand();
-            }
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
-
-    ConsoleState operator()(const FirstOperand&) {
-        Flow<ComplexOperand> flowItem (tokens);
-        auto number = processor.process(flowItem).success();
-
-        if (number.has_value()) {
-            return Operator(number.value());
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
-
-    ConsoleState operator()(const Operator& state) {
-        Flow<Operation> flowItem (tokens);
-        std::optional<OperationType> operation = processor.process(flowItem).success();
-
-        if (operation.has_value()) {
-            OperationType operationVariant = operation.value();
-            if (std::holds_alternative<Function>(operationVariant)) {
-                return MethodResult(state.firstOperand, std::get<Function>(operationVariant));
-            } else if (std::holds_alternative<BinaryComplexOperation>(operationVariant)) {
-                return SecondOperand(state.firstOperand, std::get<BinaryComplexOperation>(operationVariant));
-            } else {
-                return SecondDoubleOperand(state.firstOperand, std::get<BinaryComplexDoubleOperation>(operationVariant));
-            }
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
-
-    ConsoleState operator()(const SecondOperand& state) {
-        Flow<ComplexOperand> flowItem (tokens);
-        auto number = processor.process(flowItem).success();
-
-        if (number.has_value()) {
-            return BinaryComplexResult(ComplexOperands (state.firstOperand, number.value()), state.operation);
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
+// Indexed like ConsoleState, for the transition counts.
+inline constexpr std::array<const char*, std::variant_size_v<ConsoleState>> consoleStateNames = {
+    "idle",
+    "first_operand",
+    "operator",
+    "second_operand",
+    "second_double_operand",
+    "exponent",
+    "method_result",
+    "binary_complex_result",
+    "binary_complex_double_result",
+    "error_result",
+    "end"
+};
 
-    ConsoleState operator()(const SecondDoubleOperand& state) {
-        Flow<DoubleOperand> flowItem (tokens);
-        auto doubleValue = processor.process(flowItem).success();
+// The state a next() goes to; only wraps ConsoleState, which the states
+// can't name before it is complete.
+struct ConsoleTransition {
+    ConsoleState state;
 
-        if (doubleValue.has_value()) {
-            return BinaryComplexDoubleResult(MixedOperands (state.firstOperand, doubleValue.value()), state.operation);
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
+    template <typename State>
+    ConsoleTransition(State state): state(std::move(state)) {};
+};
 
-    ConsoleState operator()(const BinaryComplexResult&) {
-        Flow<Menu> flowItem (tokens);
-        std::optional<MenuItems> menuItem = processor.process(flowItem).success();
+// MARK: - Transitions
 
-        if (menuItem.has_value()) {
-            switch (menuItem.value()) {
-                case MenuItems::EXIT:
-                    return End();
-                case MenuItems::TARGET:
-                    return FirstOperand();
-            }
-        } else {
-            return ErrorResult("Invalid Input");
-        }
+inline ConsoleTransition MenuTransition::next(MenuItems item) const {
+    if (item == MenuItems::EXIT) {
+        return End();
     }
+    return FirstOperand();
+}
 
-    ConsoleState operator()(const BinaryComplexDoubleResult&) {
-        Flow<Menu> flowItem (tokens);
-        std::optional<MenuItems> menuItem = processor.process(flowItem).success();
+inline ConsoleTransition FirstOperand::next(const ComplexNumber& operand) const {
+    return Operator(operand);
+}
 
-        if (menuItem.has_value()) {
-            switch (menuItem.value()) {
-                case MenuItems::EXIT:
-                    return End();
-                case MenuItems::TARGET:
-                    return FirstOperand();
-            }
-        } else {
-            return ErrorResult("Invalid Input");
+inline ConsoleTransition Operator::next(const OperationType& operation) const {
+    if (std::holds_alternative<Function>(operation)) {
+        auto function = std::get<Function>(operation);
+        if (takesExponent(function)) {
+            return Exponent(firstOperand, function);
         }
+        return MethodResult(firstOperand, function);
+    } else if (std::holds_alternative<BinaryComplexOperation>(operation)) {
+        return SecondOperand(firstOperand, std::get<BinaryComplexOperation>(operation));
     }
+    return SecondDoubleOperand(firstOperand, std::get<BinaryComplexDoubleOperation>(operation));
+}
 
-    ConsoleState operator()(const MethodResult&) {
-        Flow<Menu> flowItem (tokens);
-        std::optional<MenuItems> menuItem = processor.process(flowItem).success();
-
-        if (menuItem.has_value()) {
-            switch (menuItem.value()) {
-                case MenuItems::EXIT:
-                    return End();
-                case MenuItems::TARGET:
-                    return FirstOperand();
-            }
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
+inline ConsoleTransition SecondOperand::next(const ComplexNumber& secondOperand) const {
+    return BinaryComplexResult(ComplexOperands(firstOperand, secondOperand), operation);
+}
 
-    ConsoleState operator()(const ErrorResult&) {
-        Flow<Menu> flowItem (tokens);
-        std::optional<MenuItems> menuItem = processor.process(flowItem).success();
+inline ConsoleTransition SecondDoubleOperand::next(double secondOperand) const {
+    return BinaryComplexDoubleResult(MixedOperands(firstOperand, secondOperand), operation);
+}
 
-        if (menuItem.has_value()) {
-            switch (menuItem.value()) {
-                case MenuItems::EXIT:
-                    return End();
-                case MenuItems::TARGET:
-                    return FirstOperand();
-            }
-        } else {
-            return ErrorResult("Invalid Input");
-        }
-    }
+inline ConsoleTransition Exponent::next(double exponent) const {
+    return MethodResult(operand, method, exponent);
+}
 
-    ConsoleState operator()(const End&) {
-        return End();
-    }
+inline ConsoleTransition End::next(MenuItems) const {
+    return End();
+}
 
-};
+// MARK: - Console
 
+// Reads a line per step: the current state's Input picks the
+// FlowProcessor overload at compile time and its next() the state after,
+// so a step is one visit, one parse and the prompt appended to a reused
+// buffer. Ends after "Bye" or at the end of the input.
+//
+// The output is flushed only when the input has nothing buffered, i.e.
+// before waiting for someone to type, rather than on every read as a tied
+// stream would: a piped script then costs no write per line.
 class Console {
 private:
     Tokenizer tokenizer = Tokenizer();
+    FlowProcessor processor = FlowProcessor();
     ConsoleState state = Idle();
-    std::string buffer;
+    std::string line;
+    std::string output;
+    RequestArena arena;
+
+    ConsoleState step(const TokenList& tokens) const {
+        return std::visit([this, &tokens](const auto& current) -> ConsoleState {
+            typedef typename std::decay_t<decltype(current)>::Input Input;
+            auto result = processor.process(Flow<Input>(tokens));
+            if (result.hasError()) {
+                return ErrorResult(result.error());
+            }
+            return current.next(result.success()).state;
+        }, state);
+    }
 public:
-    void start() {
+    Console() {
+        Metrics::nameStates(consoleStateNames);
+    }
+
+    void start(std::istream& input = std::cin, std::ostream& stream = std::cout) {
+        auto tied = input.tie(nullptr);
         while (true) {
-            std::visit([](StateInfo& informator) { std::cout << informator.getInfo(); }, state);
-            if (std::holds_alternative<End>(state)) {
+            output.clear();
+            {
+                StageTimer timer (Stage::FORMAT);
+                std::visit([this](const auto& current) { current.write(output); }, state);
+            }
+            stream.write(output.data(), output.size());
+            if (std::holds_alternative<End>(state) || input.rdbuf()->in_avail() <= 0) {
+                stream.flush();
+            }
+            if (std::holds_alternative<End>(state) || !std::getline(input, line)) {
+                input.tie(tied);
                 return;
             }
-            getline(std::cin, buffer);
-            auto tokens = tokenizer.tokenize(buffer);
-            auto event = NewTokensEvent(tokens);
-            state = std::visit(event, state);
+            Metrics::count(Counter::LINES);
+            arena.reset();
+            auto previous = state.index();
+            state = step(tokenizer.tokenize(line, arena.resource()));
+            Metrics::transition(previous, state.index());
+            if (std::holds_alternative<ErrorResult>(state)) {
+                Metrics::count(Counter::ERRORS);
+            }
         }
     }
 };
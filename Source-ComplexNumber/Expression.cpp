@@ -0,0 +1,364 @@
+//
+//  Expression.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <algorithm>
+#include <optional>
+
+#include "Expression.hpp"
+#include "Flow.hpp"
+#include "FlowProcessor.hpp"
+
+// MARK: - Evaluation
+
+template <typename Scalar>
+BasicComplexNumber<Scalar> BasicCompiledExpression<Scalar>::evaluate(std::vector<BasicLazyComplexNumber<Scalar>>& stack) const {
+    typedef BasicLazyComplexNumber<Scalar> Value;
+
+    stack.clear();
+    stack.reserve(stackDepth);
+
+    for (const auto& instruction: instructions) {
+        if (instruction.code == OpCode::PUSH) {
+            stack.push_back(constants[instruction.operand]);
+            continue;
+        }
+
+        auto& top = stack.back();
+        switch (instruction.code) {
+            case OpCode::NEGATE:
+                top = -top;
+                continue;
+            case OpCode::MODULUS:
+                top = Value(BasicComplexNumber<Scalar>(top.modulus(), 0));
+                continue;
+            case OpCode::ARGUMENT:
+                top = Value(BasicComplexNumber<Scalar>(top.argument(), 0));
+                continue;
+            case OpCode::EXPONENT:
+                top = top.exponential();
+                continue;
+            case OpCode::LOGARITHM:
+                top = top.logarithm();
+                continue;
+            default:
+                break;
+        }
+
+        auto second = stack.back();
+        stack.pop_back();
+        auto& first = stack.back();
+        switch (instruction.code) {
+            case OpCode::ADD:
+                first = first + second;
+                break;
+            case OpCode::SUBTRACT:
+                first = first - second;
+                break;
+            case OpCode::MULTIPLY:
+                first = first * second;
+                break;
+            case OpCode::DIVIDE:
+                first = first / second;
+                break;
+            case OpCode::POWER:
+                first = first.power(second);
+                break;
+            case OpCode::ROOT:
+                first = first.root(second);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return stack.back().cartesianForm();
+}
+
+template <typename Scalar>
+BasicComplexNumber<Scalar> BasicCompiledExpression<Scalar>::evaluate() const {
+    std::vector<BasicLazyComplexNumber<Scalar>> stack;
+    return evaluate(stack);
+}
+
+// MARK: - Parsing
+
+bool isImaginaryLiteral(std::string_view expression) {
+    return expression.find_first_of("iI") != std::string_view::npos;
+}
+
+bool isSignedLiteral(std::string_view expression) {
+    return !expression.empty() && (expression[0] == '+' || expression[0] == '-');
+}
+
+// Every level of brackets, signs and function operands costs a few stack
+// frames of the parser, so a line can't nest deeper than this.
+const size_t maximalExpressionNesting = 256;
+
+// Recursive descent over the tokens, emitting postfix code as it goes.
+// Each parse function returns the error that stopped it, if any.
+template <typename Scalar>
+class ExpressionParser {
+private:
+    const TokenList& tokens;
+    BasicCompiledExpression<Scalar>& expression;
+    BasicFlowProcessor<Scalar> processor = BasicFlowProcessor<Scalar>();
+    TokenList literal;
+    size_t index = 0;
+    size_t depth = 0;
+    size_t nesting = 0;
+
+    const Token* peek() {
+        while (index < tokens.size() && std::holds_alternative<TypedExpression<SpaceExpr>>(tokens[index])) {
+            ++index;
+        }
+        return index < tokens.size() ? &tokens[index] : nullptr;
+    }
+
+    template <typename Expr>
+    const TypedExpression<Expr>* peekAs() {
+        auto token = peek();
+        return token != nullptr ? std::get_if<TypedExpression<Expr>>(token) : nullptr;
+    }
+
+    bool peekOperation(std::string_view operation) {
+        auto token = peekAs<OperationExpr>();
+        return token != nullptr && token->expression == operation;
+    }
+
+    Error unexpected() {
+        auto token = peek();
+        if (token == nullptr) {
+            return Error("unexpected end of expression", endPosition());
+        }
+        return Error("unexpected token", tokenPosition(*token));
+    }
+
+    size_t endPosition() const {
+        if (tokens.empty()) {
+            return 0;
+        }
+        return std::visit([](const auto& token) { return token.position + token.expression.size(); }, tokens.back());
+    }
+
+    void emit(OpCode code, uint32_t operand = 0) {
+        expression.instructions.push_back(Instruction {code, operand});
+        if (code == OpCode::PUSH) {
+            depth += 1;
+            expression.stackDepth = std::max(expression.stackDepth, depth);
+        } else if (code == OpCode::ADD || code == OpCode::SUBTRACT || code == OpCode::MULTIPLY || code == OpCode::DIVIDE || code == OpCode::POWER || code == OpCode::ROOT) {
+            depth -= 1;
+        }
+    }
+
+    void emitFunction(Function function) {
+        switch (function) {
+            case Function::MODULUS:
+                return emit(OpCode::MODULUS);
+            case Function::ARGUMENT:
+                return emit(OpCode::ARGUMENT);
+            case Function::POWER:
+                return emit(OpCode::POWER);
+            case Function::ROOT:
+                return emit(OpCode::ROOT);
+            case Function::EXPONENT:
+                return emit(OpCode::EXPONENT);
+            case Function::LOGARITHM:
+                return emit(OpCode::LOGARITHM);
+        }
+    }
+
+    // A function of one operand, i.e. anything but power and root.
+    const TypedExpression<FunctionExpr>* peekUnaryFunction() {
+        auto function = peekAs<FunctionExpr>();
+        return function != nullptr && !takesExponent(functionNamed(function->expression)) ? function : nullptr;
+    }
+
+    std::optional<Error> parseLiteral() {
+        auto first = peekAs<ComplexExpr>();
+        literal.assign(1, *first);
+        ++index;
+
+        auto second = peekAs<ComplexExpr>();
+        if (second != nullptr && isImaginaryLiteral(first->expression) != isImaginaryLiteral(second->expression)) {
+            literal.push_back(*second);
+            ++index;
+        }
+
+        auto number = processor.process(Flow<ComplexOperand>(literal));
+        if (number.hasError()) {
+            return number.error();
+        }
+        // Converted once here, so products with a polar value don't have to.
+        BasicLazyComplexNumber<Scalar> constant (number.success());
+        constant.polarForm();
+        expression.constants.push_back(constant);
+        emit(OpCode::PUSH, static_cast<uint32_t>(expression.constants.size() - 1));
+        return std::nullopt;
+    }
+
+    std::optional<Error> parsePrimary() {
+        if (peekAs<ComplexExpr>() != nullptr) {
+            return parseLiteral();
+        }
+
+        if (auto function = peekUnaryFunction()) {
+            auto applied = functionNamed(function->expression);
+            ++index;
+            if (auto error = parseUnary()) {
+                return error;
+            }
+            emitFunction(applied);
+            return std::nullopt;
+        }
+
+        auto bracket = peekAs<ParenthesisExpr>();
+        if (bracket == nullptr || bracket->expression != "(") {
+            return unexpected();
+        }
+        ++index;
+        if (auto error = parseExpression()) {
+            return error;
+        }
+        bracket = peekAs<ParenthesisExpr>();
+        if (bracket == nullptr || bracket->expression != ")") {
+            return unexpected();
+        }
+        ++index;
+        return std::nullopt;
+    }
+
+    std::optional<Error> parsePostfix() {
+        if (auto error = parsePrimary()) {
+            return error;
+        }
+        while (auto function = peekUnaryFunction()) {
+            ++index;
+            emitFunction(functionNamed(function->expression));
+        }
+        return std::nullopt;
+    }
+
+    // The exponent is a unary, which can be another power: right associative.
+    std::optional<Error> parsePower() {
+        if (auto error = parsePostfix()) {
+            return error;
+        }
+        auto function = peekAs<FunctionExpr>();
+        if (function == nullptr) {
+            return std::nullopt;
+        }
+        auto applied = functionNamed(function->expression);
+        ++index;
+        if (auto error = parseUnary()) {
+            return error;
+        }
+        emitFunction(applied);
+        return std::nullopt;
+    }
+
+    // Every nested bracket, sign and function operand comes through here,
+    // so this is where nesting is bounded.
+    std::optional<Error> parseUnary() {
+        if (nesting == maximalExpressionNesting) {
+            auto token = peek();
+            return Error("expression nested too deeply", token != nullptr ? tokenPosition(*token) : endPosition());
+        }
+        nesting += 1;
+        auto error = parseSignedUnary();
+        nesting -= 1;
+        return error;
+    }
+
+    std::optional<Error> parseSignedUnary() {
+        if (peekOperation("-")) {
+            ++index;
+            if (auto error = parseUnary()) {
+                return error;
+            }
+            emit(OpCode::NEGATE);
+            return std::nullopt;
+        }
+        if (peekOperation("+")) {
+            ++index;
+            return parseUnary();
+        }
+        return parsePower();
+    }
+
+    std::optional<Error> parseTerm() {
+        if (auto error = parseUnary()) {
+            return error;
+        }
+        while (peekOperation("*") || peekOperation("/")) {
+            auto code = peekOperation("*") ? OpCode::MULTIPLY : OpCode::DIVIDE;
+            ++index;
+            if (auto error = parseUnary()) {
+                return error;
+            }
+            emit(code);
+        }
+        return std::nullopt;
+    }
+
+    // A signed number right after an operand ("(1+i)-2") is an addition of
+    // that signed number, which is the same as the subtraction it reads as.
+    std::optional<Error> parseExpression() {
+        if (auto error = parseTerm()) {
+            return error;
+        }
+        while (true) {
+            auto code = OpCode::ADD;
+            if (peekOperation("+") || peekOperation("-")) {
+                code = peekOperation("+") ? OpCode::ADD : OpCode::SUBTRACT;
+                ++index;
+            } else if (auto number = peekAs<ComplexExpr>(); number == nullptr || !isSignedLiteral(number->expression)) {
+                return std::nullopt;
+            }
+            if (auto error = parseTerm()) {
+                return error;
+            }
+            emit(code);
+        }
+    }
+public:
+    ExpressionParser(const TokenList& tokens, BasicCompiledExpression<Scalar>& expression): tokens(tokens), expression(expression), literal(tokens.get_allocator()) {};
+
+    std::optional<Error> parse() {
+        if (auto error = parseExpression()) {
+            return error;
+        }
+        if (peek() != nullptr) {
+            return unexpected();
+        }
+        return std::nullopt;
+    }
+};
+
+// MARK: - Compiler
+
+template <typename Scalar>
+Result<BasicCompiledExpression<Scalar>> BasicExpressionCompiler<Scalar>::compile(const TokenList& tokens) const {
+    BasicCompiledExpression<Scalar> expression;
+    auto error = ExpressionParser<Scalar>(tokens, expression).parse();
+    if (error.has_value()) {
+        return Result<BasicCompiledExpression<Scalar>>(error.value());
+    }
+    return Result<BasicCompiledExpression<Scalar>>(std::move(expression));
+}
+
+template <typename Scalar>
+Result<BasicCompiledExpression<Scalar>> BasicExpressionCompiler<Scalar>::compile(std::string_view input) const {
+    return compile(Tokenizer().tokenize(input));
+}
+
+template class BasicCompiledExpression<float>;
+template class BasicCompiledExpression<double>;
+template class BasicCompiledExpression<long double>;
+
+template struct BasicExpressionCompiler<float>;
+template struct BasicExpressionCompiler<double>;
+template struct BasicExpressionCompiler<long double>;
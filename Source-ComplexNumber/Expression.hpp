@@ -0,0 +1,93 @@
+//
+//  Expression.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef Expression_hpp
+#define Expression_hpp
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "ComplexNumber.hpp"
+#include "PolarNumber.hpp"
+#include "Result.hpp"
+#include "Tokenizer.hpp"
+
+enum class OpCode: uint8_t {
+    PUSH,
+    NEGATE,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    MODULUS,
+    ARGUMENT,
+    POWER,
+    ROOT,
+    EXPONENT,
+    LOGARITHM
+};
+
+struct Instruction {
+    OpCode code;
+    uint32_t operand;
+};
+
+// Flat postfix program over a constant pool. Compiled once, it can be
+// evaluated any number of times without touching the tokens again.
+// Constants are parsed, and the program runs, at the precision of Scalar.
+// Values on the stack are BasicLazyComplexNumbers, so every instruction
+// works in the form its operands already hold and a chain of products,
+// quotients and powers converts to polar and back once.
+template <typename Scalar>
+class BasicCompiledExpression {
+private:
+    std::vector<Instruction> instructions;
+    std::vector<BasicLazyComplexNumber<Scalar>> constants;
+    size_t stackDepth = 0;
+
+    template <typename> friend class ExpressionParser;
+public:
+    size_t size() const { return instructions.size(); }
+    size_t maximalStackDepth() const { return stackDepth; }
+
+    // stack is scratch space, reused between calls to avoid allocations.
+    // A compiled program is never changed by evaluating it, so threads may
+    // share one as long as each brings its own stack.
+    BasicComplexNumber<Scalar> evaluate(std::vector<BasicLazyComplexNumber<Scalar>>& stack) const;
+    BasicComplexNumber<Scalar> evaluate() const;
+};
+
+typedef BasicCompiledExpression<double> CompiledExpression;
+
+// Grammar, lowest precedence first:
+//   expression  term (("+" | "-") term)*
+//   term        unary (("*" | "/") unary)*
+//   unary       ("-" | "+") unary | power
+//   power       postfix (("power" | "root") unary)?
+//   postfix     primary function*
+//   primary     literal | "(" expression ")" | function unary
+//   literal     one complex token, or a real and an imaginary one, e.g. "2+i3"
+//   function    modulus | arg | exp | log
+// power and root are right associative and bind tighter than a sign, so
+// "-(1+i) power 2" is -2i; the exponent may be complex. Real-valued functions
+// (modulus, arg) give a number with zero imaginary part.
+// A real and an imaginary number next to each other form one literal, so
+// "2+i3" is a constant; any other signed number after an operand is added,
+// so "2-3" and "(1+i)-2" work without spaces.
+// Brackets, signs and function operands nest at most 256 deep; a deeper
+// line is an error rather than a stack overflow.
+// Expression.cpp instantiates float, double and long double.
+template <typename Scalar>
+struct BasicExpressionCompiler {
+    Result<BasicCompiledExpression<Scalar>> compile(std::string_view input) const;
+    Result<BasicCompiledExpression<Scalar>> compile(const TokenList& tokens) const;
+};
+
+typedef BasicExpressionCompiler<double> ExpressionCompiler;
+
+#endif /* Expression_hpp */
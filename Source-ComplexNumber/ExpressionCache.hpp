@@ -0,0 +1,113 @@
+//
+//  ExpressionCache.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef ExpressionCache_hpp
+#define ExpressionCache_hpp
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+struct CacheStatistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+};
+
+// Cache key for a line: surrounding spaces dropped and runs of spaces
+// squeezed to one, so "2+i3 *  4 " and "2+i3 * 4" share an entry. Spaces
+// are kept rather than removed because they separate tokens, and letter
+// case is kept because the flows treat it differently. Only ' ' is folded:
+// the tokenizer has no other whitespace, so a tab is an error and must key
+// apart from a space. key is reused between calls to avoid allocations.
+inline void normalizeExpression(std::string_view line, std::string& key) {
+    key.clear();
+    bool pendingSpace = false;
+    for (char character: line) {
+        if (character == ' ') {
+            pendingSpace = !key.empty();
+            continue;
+        }
+        if (pendingSpace) {
+            key += ' ';
+            pendingSpace = false;
+        }
+        key += character;
+    }
+}
+
+// Bounded least recently used map from normalized input text to whatever
+// the line was parsed into. Entries live in a list ordered from most to
+// least recently used; the index keys are views into the list's strings,
+// so a lookup by string_view allocates nothing. Once full, the oldest
+// entry's nodes are reused for the new one. Capacity 0 disables caching.
+template <typename Value>
+class ExpressionCache {
+private:
+    typedef std::pair<std::string, Value> Entry;
+    typedef typename std::list<Entry>::iterator EntryIterator;
+
+    std::list<Entry> entries;
+    std::unordered_map<std::string_view, EntryIterator> index;
+    size_t capacity;
+    CacheStatistics statistics;
+public:
+    explicit ExpressionCache(size_t capacity): capacity(capacity) {
+        index.reserve(capacity);
+    };
+
+    ExpressionCache(const ExpressionCache&) = delete;
+    ExpressionCache& operator=(const ExpressionCache&) = delete;
+
+    bool isEnabled() const { return capacity > 0; }
+    size_t size() const { return entries.size(); }
+    const CacheStatistics& getStatistics() const { return statistics; }
+
+    // The cached value, marked as most recently used, or nullptr. The
+    // pointer stays valid until the next insert.
+    const Value* find(std::string_view key) {
+        auto found = index.find(key);
+        if (found == index.end()) {
+            statistics.misses += 1;
+            return nullptr;
+        }
+        statistics.hits += 1;
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->second;
+    }
+
+    void insert(std::string_view key, Value value) {
+        if (capacity == 0 || index.find(key) != index.end()) {
+            return;
+        }
+
+        if (entries.size() < capacity) {
+            entries.emplace_front(std::string(key), std::move(value));
+            index.emplace(entries.front().first, entries.begin());
+            return;
+        }
+
+        statistics.evictions += 1;
+        auto oldest = std::prev(entries.end());
+        auto node = index.extract(oldest->first);
+        oldest->first.assign(key.data(), key.size());
+        oldest->second = std::move(value);
+        entries.splice(entries.begin(), entries, oldest);
+
+        node.key() = oldest->first;
+        index.insert(std::move(node));
+    }
+
+    void clear() {
+        index.clear();
+        entries.clear();
+    }
+};
+
+#endif /* ExpressionCache_hpp */
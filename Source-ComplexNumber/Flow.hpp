@@ -12,13 +12,15 @@
 
 #include "Tokenizer.hpp"
 
+// A typed view over tokens owned by the caller; nothing is copied. The
+// tokens must be a named list that outlives the flow, so a temporary one,
+// e.g. straight from tokenize(), doesn't compile.
 template <typename Step>
 struct Flow {
-    std::vector<Token> tokens;
+    const TokenList& tokens;
 
-    Flow(std::vector<Token>& tokens) {
-        this->tokens = tokens;
-    }
+    Flow(const TokenList& tokens): tokens(tokens) {};
+    Flow(TokenList&&) = delete;
 };
 
 struct ComplexOperand {};
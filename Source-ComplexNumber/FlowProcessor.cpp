@@ -5,175 +5,224 @@
 //  Created by Egor Mikhailov on 05.09.2021.
 //
 
-#include <algorithm>
-#include <iterator>
-#include <map>
-#include <functional>
+#include <array>
+#include <charconv>
 #include <optional>
-#include <numeric>
+#include <type_traits>
 
 #include "FlowProcessor.hpp"
+#include "Instrumentation.hpp"
 
-template<typename NumberType>
+template<typename NumberType, typename Scalar>
 struct Number {
-    double value;
-    Number<NumberType>(double value): value(value) {};
+    Scalar value;
+    Number(Scalar value): value(value) {};
 };
 
 struct Real {};
 struct Imaginary {};
 
-std::variant<Number<Real>, Number<Imaginary>> evaluate(std::string expression) {
-    auto result = std::find(expression.begin(), expression.end(), 'i');
-    if (result == std::end(expression)) {
-        return Number<Real>(std::stod(expression));
-    } else {
-        expression.erase(result);
-        if (expression == "-" || expression == "+") {
-            expression.append("1");
+template <typename Scalar>
+using ParsedNumber = std::variant<Number<Real, Scalar>, Number<Imaginary, Scalar>>;
+
+// Parses a complex token in place: an optional sign, an optional i and
+// digits, where a bare "i" means one. from_chars neither allocates nor
+// depends on the locale. An empty result means the digits don't fit Scalar.
+template <typename Scalar>
+std::optional<ParsedNumber<Scalar>> evaluate(std::string_view expression) {
+    bool isNegative = false;
+    if (!expression.empty() && (expression[0] == '+' || expression[0] == '-')) {
+        isNegative = expression[0] == '-';
+        expression.remove_prefix(1);
+    }
+
+    bool isImaginary = !expression.empty() && (expression[0] == 'i' || expression[0] == 'I');
+    if (isImaginary) {
+        expression.remove_prefix(1);
+    }
+
+    Scalar value = 1;
+    if (!expression.empty()) {
+        auto end = expression.data() + expression.size();
+        auto result = std::from_chars(expression.data(), end, value);
+        if (result.ec != std::errc() || result.ptr != end) {
+            return std::nullopt;
         }
-        return Number<Imaginary>(std::stod(expression));
+    } else if (!isImaginary) {
+        return std::nullopt;
     }
+
+    value = isNegative ? -value : value;
+    if (isImaginary) {
+        return ParsedNumber<Scalar>(Number<Imaginary, Scalar>(value));
+    }
+    return ParsedNumber<Scalar>(Number<Real, Scalar>(value));
 }
 
-std::optional<ComplexNumber> processArgs(std::vector<TypedExpression<ComplexExpr>> args) {
-    auto first = evaluate(args[0].expression);
-    auto second = [args, first]() -> std::variant<Number<Real>, Number<Imaginary>> {
-        if (args.size() == 1) {
-            if (std::holds_alternative<Number<Real>>(first)) {
-                return Number<Imaginary>(0.0);
-            } else {
-                return Number<Real>(0.0);
+// MARK: - Filtering
+
+// Tokens of one expression type picked out of a flow in place: they point
+// into the flow's token list, so nothing is copied. The first Capacity are
+// kept and all are counted.
+template <typename Expression, size_t Capacity>
+struct TokenMatches {
+    std::array<const TypedExpression<Expression>*, Capacity> tokens {};
+    size_t count = 0;
+    std::optional<size_t> lastPosition = std::nullopt;
+    std::optional<size_t> strayPosition = std::nullopt;
+
+    // Spaces are skipped; the first token of any other type is stray.
+    void classify(const Token& token) {
+        if (auto match = std::get_if<TypedExpression<Expression>>(&token)) {
+            if (count < Capacity) {
+                tokens[count] = match;
             }
-        } else {
-            return evaluate(args[1].expression);
+            count += 1;
+            lastPosition = match->position;
+        } else if (!std::holds_alternative<TypedExpression<SpaceExpr>>(token) && !strayPosition.has_value()) {
+            strayPosition = tokenPosition(token);
         }
-    }();
+    }
 
-    if (std::holds_alternative<Number<Real>>(first) && std::holds_alternative<Number<Real>>(second)) {
-        return std::nullopt;
-    } else if (std::holds_alternative<Number<Imaginary>>(first) && std::holds_alternative<Number<Imaginary>>(second)) {
-        return std::nullopt;
+    // minimalCount up to Capacity matches and no stray tokens.
+    bool accepts(size_t minimalCount) const {
+        return !strayPosition.has_value() && count >= minimalCount && count <= Capacity;
+    }
+
+    size_t size() const { return count; }
+    const TypedExpression<Expression>& operator[](size_t index) const { return *tokens[index]; }
+    const TypedExpression<Expression>& back() const { return *tokens[count - 1]; }
+};
+
+// The matches when they are accepted, otherwise the reason they are not.
+template <typename Expression, size_t Capacity>
+Result<TokenMatches<Expression, Capacity>> checkMatches(const TokenMatches<Expression, Capacity>& matches, bool isEmpty, size_t minimalCount) {
+    typedef Result<TokenMatches<Expression, Capacity>> MatchesResult;
+
+    if (isEmpty) {
+        return MatchesResult(Error("empty input"));
+    } else if (matches.strayPosition.has_value()) {
+        return MatchesResult(Error("unexpected token", matches.strayPosition));
+    } else if (!matches.accepts(minimalCount)) {
+        return MatchesResult(Error("wrong number of tokens", matches.lastPosition));
     } else {
-        auto real = std::holds_alternative<Number<Imaginary>>(first) ? std::get<Number<Real>>(second) : std::get<Number<Real>>(first);
-        auto imaginary = std::holds_alternative<Number<Real>>(first) ? std::get<Number<Imaginary>>(second) : std::get<Number<Imaginary>>(first);
-        return ComplexNumber(real.value, imaginary.value);
+        return MatchesResult(matches);
     }
 }
 
-typedef std::function<bool(const Token&)> TokenTypeHandler;
-typedef std::function<bool(const unsigned long)> VectorSizeHandler;
-
-std::optional<std::vector<Token>> filter(std::vector<Token>& tokens, TokenTypeHandler targetTokenHandler, VectorSizeHandler sizeHandler) {
-    if (tokens.empty()) {
-        return std::nullopt;
+// Single pass over the tokens, O(n) and allocation free.
+template <typename Expression, size_t Capacity>
+Result<TokenMatches<Expression, Capacity>> filter(const TokenList& tokens, size_t minimalCount) {
+    TokenMatches<Expression, Capacity> matches;
+    for (const auto& token: tokens) {
+        matches.classify(token);
     }
+    return checkMatches(matches, tokens.empty(), minimalCount);
+}
 
-    bool hasError = false;
+// MARK: - Processing
 
-    auto filteredTokens = std::accumulate(tokens.begin(), tokens.end(), std::vector<Token>(), [targetTokenHandler, &hasError](std::vector<Token>& tokens, const Token& token) mutable {
-        if (targetTokenHandler(token)) {
-            tokens.push_back(token);
-        } else if (!std::holds_alternative<TypedExpression<SpaceExpr>>(token)) {
-            hasError = true;
-        }
+template <typename Scalar>
+Result<BasicComplexNumber<Scalar>> processArgs(const TokenMatches<ComplexExpr, 2>& args) {
+    typedef Number<Real, Scalar> RealNumber;
+    typedef Number<Imaginary, Scalar> ImaginaryNumber;
 
-        return tokens;
-    });
+    auto parsedFirst = evaluate<Scalar>(args[0].expression);
+    if (!parsedFirst.has_value()) {
+        return Result<BasicComplexNumber<Scalar>>(Error("invalid number", args[0].position));
+    }
+    auto first = parsedFirst.value();
 
-    if (!sizeHandler(filteredTokens.size()) || hasError) {
-        return std::nullopt;
+    ParsedNumber<Scalar> second = ImaginaryNumber(0);
+    if (args.size() == 1) {
+        if (std::holds_alternative<ImaginaryNumber>(first)) {
+            second = RealNumber(0);
+        }
     } else {
-        return std::make_optional(filteredTokens);
+        auto parsedSecond = evaluate<Scalar>(args[1].expression);
+        if (!parsedSecond.has_value()) {
+            return Result<BasicComplexNumber<Scalar>>(Error("invalid number", args[1].position));
+        }
+        second = parsedSecond.value();
     }
-}
-
-Result<ComplexNumber> FlowProcessor::process(Flow<ComplexOperand> flow) const {
-    auto tokenTypeHandler = [](const Token& token) { return std::holds_alternative<TypedExpression<ComplexExpr>>(token); };
-    auto tokensSizeHandler = [](const unsigned long size) { return size > 0 && size <= 2; };
-    auto filteredTokens = filter(flow.tokens, tokenTypeHandler, tokensSizeHandler);
 
-    if (!filteredTokens.has_value()) {
-        return Result<ComplexNumber>(Error("non valid arg"));
-    }
-    else {
-        auto filteredTokensVec = filteredTokens.value();
-        std::vector<TypedExpression<ComplexExpr>> args {};
-        std::transform(filteredTokensVec.begin(), filteredTokensVec.end(), std::back_inserter(args), [](const Token token) -> TypedExpression<ComplexExpr> {
-            return std::get<TypedExpression<ComplexExpr>>(token);
-        });
-        auto result = processArgs(args);
-        return result.has_value() ? Result<ComplexNumber>(result.value()) : Result<ComplexNumber>(Error("non valid arg"));
+    if (std::holds_alternative<RealNumber>(first) && std::holds_alternative<RealNumber>(second)) {
+        return Result<BasicComplexNumber<Scalar>>(Error("second real part", args.back().position));
+    } else if (std::holds_alternative<ImaginaryNumber>(first) && std::holds_alternative<ImaginaryNumber>(second)) {
+        return Result<BasicComplexNumber<Scalar>>(Error("second imaginary part", args.back().position));
+    } else {
+        auto real = std::holds_alternative<ImaginaryNumber>(first) ? std::get<RealNumber>(second) : std::get<RealNumber>(first);
+        auto imaginary = std::holds_alternative<RealNumber>(first) ? std::get<ImaginaryNumber>(second) : std::get<ImaginaryNumber>(first);
+        return Result<BasicComplexNumber<Scalar>>(BasicComplexNumber<Scalar>(real.value, imaginary.value));
     }
 }
 
-Result<MenuItems> FlowProcessor::process(Flow<Menu> flow) const {
-    auto tokenTypeHandler = [](const Token& token) { return std::holds_alternative<TypedExpression<MenuExpr>>(token); };
-    auto tokensSizeHandler = [](const unsigned long size) { return size == 1; };
-    auto filteredTokens = filter(flow.tokens, tokenTypeHandler, tokensSizeHandler);
 
-    if (!filteredTokens.has_value()) {
-        return Result<MenuItems>(Error("non valid arg"));
-    } else {
-        auto menuItem = std::get<TypedExpression<MenuExpr>>(filteredTokens.value()[0]);
-        auto menuItemInt = menuItem.expression == "A" ? 0 : 1;
-        return Result<MenuItems>(static_cast<MenuItems>(menuItemInt));
-    }
+template <typename Scalar>
+Result<BasicComplexNumber<Scalar>> BasicFlowProcessor<Scalar>::process(const Flow<ComplexOperand>& flow) const {
+    StageTimer timer (Stage::PROCESS_COMPLEX_OPERAND);
+    return filter<ComplexExpr, 2>(flow.tokens, 1).and_then([](const TokenMatches<ComplexExpr, 2>& args) {
+        return processArgs<Scalar>(args);
+    });
 }
 
-Result<OperationType> FlowProcessor::process(Flow<Operation> flow) const {
-    std::function<bool(const Token&)> typeHandlerOperation = [](const Token& token) {
-        return std::holds_alternative<TypedExpression<OperationExpr>>(token);
-    };
-
-    std::function<bool(const Token&)> typeHandlerFunction = [](const Token& token) {
-        return std::holds_alternative<TypedExpression<FunctionExpr>>(token);
-    };
-    auto tokensSizeHandler = [](const unsigned long size) { return size == 1; };
+template <typename Scalar>
+Result<MenuItems> BasicFlowProcessor<Scalar>::process(const Flow<Menu>& flow) const {
+    StageTimer timer (Stage::PROCESS_MENU);
+    return filter<MenuExpr, 1>(flow.tokens, 1).transform([](const TokenMatches<MenuExpr, 1>& matches) {
+        return matches[0].expression == "A" ? MenuItems::EXIT : MenuItems::TARGET;
+    });
+}
 
-    auto operationToken = filter(flow.tokens, typeHandlerOperation, tokensSizeHandler);
-    auto functionToken = filter(flow.tokens, typeHandlerFunction, tokensSizeHandler);
+// An operator or a function: both are classified in the same pass, and
+// when neither fits the operator's error is reported. The error is only
+// built then, so a function doesn't allocate one on its way.
+template <typename Scalar>
+Result<OperationType> BasicFlowProcessor<Scalar>::process(const Flow<Operation>& flow) const {
+    StageTimer timer (Stage::PROCESS_OPERATION);
+    TokenMatches<OperationExpr, 1> operations;
+    TokenMatches<FunctionExpr, 1> functions;
+    for (const auto& token: flow.tokens) {
+        operations.classify(token);
+        functions.classify(token);
+    }
 
-    if (operationToken.has_value()) {
-        auto expr = std::get<TypedExpression<OperationExpr>>(operationToken.value()[0]).expression;
+    if (operations.accepts(1)) {
+        auto expr = operations[0].expression;
         if (expr == "+") {
-            return Result<OperationType>(BinaryComplexOperation([](ComplexNumber first, ComplexNumber second) { return first + second; }));
+            return Result<OperationType>(BinaryComplexOperation::PLUS);
         } else if (expr == "-") {
-            return Result<OperationType>(BinaryComplexOperation([](ComplexNumber first, ComplexNumber second) { return first - second; }));
+            return Result<OperationType>(BinaryComplexOperation::MINUS);
         } else if (expr == "/") {
-            return Result<OperationType>(BinaryComplexDoubleOperation([](ComplexNumber first, double second) { return first / second; }));
+            return Result<OperationType>(BinaryComplexDoubleOperation::DIVIDE);
         } else {
-            return Result<OperationType>(BinaryComplexDoubleOperation([](ComplexNumber first, double second) { return first * second; }));
-        }
-    } else if (functionToken.has_value()) {
-        auto expr = std::get<TypedExpression<FunctionExpr>>(functionToken.value()[0]).expression;
-        if (expr == "modulus") {
-            return Result<OperationType>(Function::MODULUS);
-        } else {
-            return Result<OperationType>(Function::ARGUMENT);
+            return Result<OperationType>(BinaryComplexDoubleOperation::MULTIPLY);
         }
+    }
+
+    if (functions.accepts(1)) {
+        return Result<OperationType>(functionNamed(functions[0].expression));
     } else {
-        return Result<OperationType>(Error("non valid arg"));
+        return Result<OperationType>(checkMatches(operations, flow.tokens.empty(), 1).error());
     }
 }
 
-Result<double> FlowProcessor::process(Flow<DoubleOperand> flow) const {
-    auto tokenTypeHandler = [](const Token& token) { return std::holds_alternative<TypedExpression<ComplexExpr>>(token); };
-    auto tokensSizeHandler = [](const unsigned long size) { return size == 1; };
-    auto filteredTokens = filter(flow.tokens, tokenTypeHandler, tokensSizeHandler);
-
-    if (filteredTokens.has_value()) {
-        auto expr = std::get<TypedExpression<ComplexExpr>>(filteredTokens.value()[0]).expression;
-        auto number = evaluate(expr);
-        if (std::holds_alternative<Number<Real>>(number)) {
-            auto doubleNumber = std::get<Number<Real>>(number).value;
-            return Result<double>(doubleNumber);
+template <typename Scalar>
+Result<Scalar> BasicFlowProcessor<Scalar>::process(const Flow<DoubleOperand>& flow) const {
+    StageTimer timer (Stage::PROCESS_DOUBLE_OPERAND);
+    return filter<ComplexExpr, 1>(flow.tokens, 1).and_then([](const TokenMatches<ComplexExpr, 1>& matches) {
+        const auto& token = matches[0];
+        auto number = evaluate<Scalar>(token.expression);
+        if (!number.has_value()) {
+            return Result<Scalar>(Error("invalid number", token.position));
         }
-    }
-    return Result<double>(Error("non-valid arg"));
+        if (std::holds_alternative<Number<Real, Scalar>>(number.value())) {
+            return Result<Scalar>(std::get<Number<Real, Scalar>>(number.value()).value);
+        }
+        return Result<Scalar>(Error("imaginary part in double operand", token.position));
+    });
 }
 
-
-
-
-
+template struct BasicFlowProcessor<float>;
+template struct BasicFlowProcessor<double>;
+template struct BasicFlowProcessor<long double>;
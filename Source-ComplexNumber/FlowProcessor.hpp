@@ -8,35 +8,84 @@
 #ifndef FlowProcessor_hpp
 #define FlowProcessor_hpp
 
+#include <string_view>
 #include <variant>
-#include <functional>
 
 #include "Flow.hpp"
 #include "Result.hpp"
 #include "ComplexNumber.hpp"
 #include "Tokenizer.hpp"
 
+// MODULUS and ARGUMENT give a real number, the others a complex one.
+// POWER and ROOT take a real exponent (the degree for ROOT) as a second
+// operand.
 enum class Function {
     MODULUS,
-    ARGUMENT
+    ARGUMENT,
+    POWER,
+    ROOT,
+    EXPONENT,
+    LOGARITHM
 };
 
+inline bool isRealValued(Function function) {
+    return function == Function::MODULUS || function == Function::ARGUMENT;
+}
+
+inline bool takesExponent(Function function) {
+    return function == Function::POWER || function == Function::ROOT;
+}
+
+// The lexer only produces "modulus", "arg", "power", "root", "exp" and
+// "log", in any case, and their first letters differ.
+inline Function functionNamed(std::string_view name) {
+    switch (name[0] | 0x20) {
+        case 'm':
+            return Function::MODULUS;
+        case 'p':
+            return Function::POWER;
+        case 'r':
+            return Function::ROOT;
+        case 'e':
+            return Function::EXPONENT;
+        case 'l':
+            return Function::LOGARITHM;
+        default:
+            return Function::ARGUMENT;
+    }
+}
+
 enum class MenuItems {
     EXIT,
     TARGET
 };
 
 
-typedef std::function<ComplexNumber(ComplexNumber, double)> BinaryComplexDoubleOperation;
-typedef std::function<ComplexNumber(ComplexNumber, ComplexNumber)> BinaryComplexOperation;
+enum class BinaryComplexOperation {
+    PLUS,
+    MINUS
+};
+
+enum class BinaryComplexDoubleOperation {
+    MULTIPLY,
+    DIVIDE
+};
+
 typedef std::variant<Function, BinaryComplexOperation, BinaryComplexDoubleOperation> OperationType;
 
-struct FlowProcessor {
-    FlowProcessor() {};
-    Result<ComplexNumber> process(Flow<ComplexOperand> flow) const;
-    Result<double> process(Flow<DoubleOperand> flow) const;
-    Result<OperationType> process(Flow<Operation> flow) const;
-    Result<MenuItems> process(Flow<Menu> flow) const;
+// Operands are parsed at the precision of Scalar; FlowProcessor.cpp
+// instantiates float, double and long double.
+// process() only reads its flow and keeps nothing between calls, so a
+// processor can be shared between threads.
+template <typename Scalar>
+struct BasicFlowProcessor {
+    BasicFlowProcessor() {};
+    Result<BasicComplexNumber<Scalar>> process(const Flow<ComplexOperand>& flow) const;
+    Result<Scalar> process(const Flow<DoubleOperand>& flow) const;
+    Result<OperationType> process(const Flow<Operation>& flow) const;
+    Result<MenuItems> process(const Flow<Menu>& flow) const;
 };
 
+typedef BasicFlowProcessor<double> FlowProcessor;
+
 #endif /* FlowProcessor_hpp */
@@ -0,0 +1,255 @@
+//
+//  Instrumentation.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <pthread.h>
+#endif
+
+#include "AllocationCounting.hpp"
+#include "Instrumentation.hpp"
+
+// MARK: - Names
+
+const char* stageName(size_t stage) {
+    static const std::array<const char*, stageCount> names = {
+        "tokenize",
+        "process_menu",
+        "process_complex_operand",
+        "process_double_operand",
+        "process_operation",
+        "calculate",
+        "format"
+    };
+    return names[stage];
+}
+
+const char* counterName(size_t counter) {
+    static const std::array<const char*, counterCount> names = {
+        "lines",
+        "tokens",
+        "errors",
+        "allocations",
+        "allocated_bytes"
+    };
+    return names[counter];
+}
+
+const std::array<double, 5> reportedPercentiles = {0.5, 0.9, 0.99, 0.999, 1};
+
+// MARK: - Snapshot
+
+// A stage's histogram summed over every shard.
+struct HistogramSnapshot {
+    std::array<uint64_t, LatencyHistogram::bucketCount> counts {};
+    uint64_t calls = 0;
+    uint64_t total = 0;
+    uint64_t sum = 0;
+
+    void add(const LatencyHistogram& histogram) {
+        for (size_t index = 0; index < LatencyHistogram::bucketCount; ++index) {
+            counts[index] += histogram.bucket(index);
+        }
+        calls += histogram.callCount();
+        total += histogram.count();
+        sum += histogram.totalNanoseconds();
+    }
+
+    // The time spent in all calls, timed or not.
+    double estimatedNanoseconds() const {
+        return total == 0 ? 0 : static_cast<double>(sum) * calls / total;
+    }
+
+    // The highest value of the bucket holding the given fraction of the
+    // values, 0 when nothing was recorded. Shards are read while their
+    // threads go on recording, so total may be a little off the buckets.
+    uint64_t percentile(double fraction) const {
+        uint64_t recorded = 0;
+        for (uint64_t count: counts) {
+            recorded += count;
+        }
+        if (recorded == 0) {
+            return 0;
+        }
+        auto rank = std::clamp<uint64_t>(static_cast<uint64_t>(fraction * recorded), 1, recorded);
+        uint64_t seen = 0;
+        for (size_t index = 0; index < LatencyHistogram::bucketCount; ++index) {
+            seen += counts[index];
+            if (seen >= rank) {
+                return LatencyHistogram::highestValue(index);
+            }
+        }
+        return 0;
+    }
+};
+
+struct MetricsSnapshot {
+    std::array<HistogramSnapshot, stageCount> stages {};
+    std::array<uint64_t, counterCount> counters {};
+};
+
+MetricsSnapshot takeSnapshot() {
+    MetricsSnapshot snapshot;
+    for (auto shard = Metrics::shards.load(std::memory_order_acquire); shard != nullptr; shard = shard->next) {
+        for (size_t stage = 0; stage < stageCount; ++stage) {
+            snapshot.stages[stage].add(shard->stages[stage]);
+        }
+        for (size_t counter = 0; counter < counterCount; ++counter) {
+            snapshot.counters[counter] += shard->counters[counter].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+// MARK: - Formatting
+
+std::string percentileLabel(double fraction) {
+    std::ostringstream label;
+    label << fraction;
+    return label.str();
+}
+
+std::string formatJSON(const MetricsSnapshot& snapshot) {
+    std::ostringstream output;
+    output << "{\n  \"stages\": {";
+    for (size_t stage = 0; stage < stageCount; ++stage) {
+        const auto& histogram = snapshot.stages[stage];
+        output << (stage == 0 ? "\n" : ",\n") << "    \"" << stageName(stage) << "\": {\"calls\": " << histogram.calls << ", \"timed\": " << histogram.total << ", \"timed_ns\": " << histogram.sum;
+        for (double fraction: reportedPercentiles) {
+            auto name = fraction == 1 ? std::string("max") : "p" + percentileLabel(fraction * 100);
+            output << ", \"" << name << "_ns\": " << histogram.percentile(fraction);
+        }
+        output << ", \"buckets\": [";
+        bool isFirst = true;
+        for (size_t index = 0; index < LatencyHistogram::bucketCount; ++index) {
+            if (uint64_t inBucket = histogram.counts[index]) {
+                output << (isFirst ? "" : ", ") << "[" << LatencyHistogram::highestValue(index) << ", " << inBucket << "]";
+                isFirst = false;
+            }
+        }
+        output << "]}";
+    }
+    output << "\n  },\n  \"counters\": {";
+    for (size_t counter = 0; counter < counterCount; ++counter) {
+        output << (counter == 0 ? "\n" : ",\n") << "    \"" << counterName(counter) << "\": " << snapshot.counters[counter];
+    }
+    output << "\n  },\n  \"state_transitions\": [";
+    bool isFirst = true;
+    for (size_t from = 0; from < maximalStateCount; ++from) {
+        for (size_t to = 0; to < maximalStateCount; ++to) {
+            uint64_t count = Metrics::transitions[from][to].load(std::memory_order_relaxed);
+            auto fromName = Metrics::stateNames[from].load(std::memory_order_acquire);
+            auto toName = Metrics::stateNames[to].load(std::memory_order_acquire);
+            if (count == 0 || fromName == nullptr || toName == nullptr) {
+                continue;
+            }
+            output << (isFirst ? "\n" : ",\n") << "    {\"from\": \"" << fromName << "\", \"to\": \"" << toName << "\", \"count\": " << count << "}";
+            isFirst = false;
+        }
+    }
+    output << (isFirst ? "]\n}\n" : "\n  ]\n}\n");
+    return output.str();
+}
+
+// Histograms as Prometheus summaries: quantiles of the timed calls, _count
+// of all calls and their _sum estimated from the timed ones, in seconds as
+// Prometheus expects.
+std::string formatPrometheus(const MetricsSnapshot& snapshot) {
+    std::ostringstream output;
+    output << "# HELP complex_stage_latency_seconds Time spent per hot path stage.\n";
+    output << "# TYPE complex_stage_latency_seconds summary\n";
+    for (size_t stage = 0; stage < stageCount; ++stage) {
+        const auto& histogram = snapshot.stages[stage];
+        for (double fraction: reportedPercentiles) {
+            output << "complex_stage_latency_seconds{stage=\"" << stageName(stage) << "\",quantile=\"" << percentileLabel(fraction) << "\"} " << histogram.percentile(fraction) * 1e-9 << "\n";
+        }
+        output << "complex_stage_latency_seconds_sum{stage=\"" << stageName(stage) << "\"} " << histogram.estimatedNanoseconds() * 1e-9 << "\n";
+        output << "complex_stage_latency_seconds_count{stage=\"" << stageName(stage) << "\"} " << histogram.calls << "\n";
+    }
+    for (size_t counter = 0; counter < counterCount; ++counter) {
+        output << "# TYPE complex_" << counterName(counter) << "_total counter\n";
+        output << "complex_" << counterName(counter) << "_total " << snapshot.counters[counter] << "\n";
+    }
+    output << "# TYPE complex_state_transitions_total counter\n";
+    for (size_t from = 0; from < maximalStateCount; ++from) {
+        for (size_t to = 0; to < maximalStateCount; ++to) {
+            uint64_t count = Metrics::transitions[from][to].load(std::memory_order_relaxed);
+            auto fromName = Metrics::stateNames[from].load(std::memory_order_acquire);
+            auto toName = Metrics::stateNames[to].load(std::memory_order_acquire);
+            if (count == 0 || fromName == nullptr || toName == nullptr) {
+                continue;
+            }
+            output << "complex_state_transitions_total{from=\"" << fromName << "\",to=\"" << toName << "\"} " << count << "\n";
+        }
+    }
+    return output.str();
+}
+
+std::string formatMetrics(MetricsFormat format) {
+    auto snapshot = takeSnapshot();
+    return format == MetricsFormat::JSON ? formatJSON(snapshot) : formatPrometheus(snapshot);
+}
+
+// MARK: - Dumping
+
+std::mutex writeMutex;
+
+bool writeMetrics(const std::string& path, MetricsFormat format) {
+    std::lock_guard<std::mutex> lock (writeMutex);
+    auto contents = formatMetrics(format);
+    auto temporaryPath = path + ".tmp";
+    {
+        std::ofstream file (temporaryPath, std::ios::trunc);
+        if (!(file << contents) || !file.flush()) {
+            return false;
+        }
+    }
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+std::string dumpPath;
+MetricsFormat dumpFormat = MetricsFormat::JSON;
+
+void dumpMetrics(const std::string& path, MetricsFormat format) {
+    dumpPath = path;
+    dumpFormat = format;
+    std::atexit([] {
+        writeMetrics(dumpPath, dumpFormat);
+    });
+
+#if !defined(_WIN32)
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::thread([signals] {
+        int signal = 0;
+        while (sigwait(&signals, &signal) == 0) {
+            writeMetrics(dumpPath, dumpFormat);
+        }
+    }).detach();
+#endif
+}
+
+// MARK: - Allocation Counting
+
+#ifdef COMPLEX_NUMBER_INSTRUMENTATION
+// Set during static initialization, so allocations are counted from the
+// start, before main.
+const bool isCountingAllocations = (observeAllocations([](size_t size) {
+    Metrics::count(Counter::ALLOCATIONS);
+    Metrics::count(Counter::ALLOCATED_BYTES, size);
+}), true);
+#endif
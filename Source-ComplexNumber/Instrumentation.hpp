@@ -0,0 +1,261 @@
+//
+//  Instrumentation.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef Instrumentation_hpp
+#define Instrumentation_hpp
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Built-in metrics for the hot path: a latency histogram per stage, a few
+// counters and how often the console moved from one state to another.
+// Every thread records into a shard of its own with plain (relaxed,
+// unlocked) stores, and a dump adds the shards up.
+//
+// Compiled in with -DCOMPLEX_NUMBER_INSTRUMENTATION. Without it every
+// recording call is an empty inline function and StageTimer an empty
+// object, so the hot path is the same code as if none of this existed.
+// Recording lives in this header; formatting and dumping the metrics are
+// in Instrumentation.cpp, which only the calculator itself needs to link,
+// together with AllocationCounting.cpp for the allocation counters.
+#ifdef COMPLEX_NUMBER_INSTRUMENTATION
+constexpr bool instrumentationEnabled = true;
+#else
+constexpr bool instrumentationEnabled = false;
+#endif
+
+enum class Stage {
+    TOKENIZE,
+    PROCESS_MENU,
+    PROCESS_COMPLEX_OPERAND,
+    PROCESS_DOUBLE_OPERAND,
+    PROCESS_OPERATION,
+    CALCULATE,
+    FORMAT
+};
+
+constexpr size_t stageCount = 7;
+
+enum class Counter {
+    LINES,
+    TOKENS,
+    ERRORS,
+    ALLOCATIONS,
+    ALLOCATED_BYTES
+};
+
+constexpr size_t counterCount = 5;
+
+// Console states are recorded by their index in ConsoleState.
+constexpr size_t maximalStateCount = 16;
+
+// Single writer store of value + amount: the owning thread is the only one
+// to change the counter, so it needs no locked instruction, and other
+// threads can still read it while it is written.
+inline void increment(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// HDR-style histogram of nanoseconds: values below 16 get a bucket each,
+// and every power of two above is split into 16 buckets, so a bucket is at
+// most 1/16 of its values wide and any uint64_t fits. Every call is
+// counted, but only one in Metrics::samplingInterval is timed: reading the
+// clock costs more than most stages. Written by one thread only.
+class LatencyHistogram {
+public:
+    static constexpr size_t subBucketBits = 4;
+    static constexpr size_t subBucketCount = 1 << subBucketBits;
+    static constexpr size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+private:
+    std::array<std::atomic<uint64_t>, bucketCount> counts {};
+    std::atomic<uint64_t> calls {0};
+    std::atomic<uint64_t> total {0};
+    std::atomic<uint64_t> sum {0};
+
+    static size_t magnitude(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+public:
+    static size_t bucketIndex(uint64_t value) {
+        if (value < subBucketCount) {
+            return value;
+        }
+        size_t shift = magnitude(value) - subBucketBits;
+        return (shift + 1) * subBucketCount + ((value >> shift) & (subBucketCount - 1));
+    }
+
+    // The largest value counted in bucket index.
+    static uint64_t highestValue(size_t index) {
+        if (index < subBucketCount) {
+            return index;
+        }
+        size_t shift = index / subBucketCount - 1;
+        return ((static_cast<uint64_t>(subBucketCount + index % subBucketCount) + 1) << shift) - 1;
+    }
+
+    // Counts a call and tells whether to time it.
+    bool countCall(uint64_t samplingInterval) {
+        uint64_t previous = calls.load(std::memory_order_relaxed);
+        calls.store(previous + 1, std::memory_order_relaxed);
+        return samplingInterval != 0 && previous % samplingInterval == 0;
+    }
+
+    void record(uint64_t nanoseconds) {
+        increment(counts[bucketIndex(nanoseconds)]);
+        increment(total);
+        increment(sum, nanoseconds);
+    }
+
+    uint64_t callCount() const { return calls.load(std::memory_order_relaxed); }
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    uint64_t totalNanoseconds() const { return sum.load(std::memory_order_relaxed); }
+    uint64_t bucket(size_t index) const { return counts[index].load(std::memory_order_relaxed); }
+};
+
+// What one thread records. A shard goes back to the pool when its thread
+// exits and is picked up, counts and all, by the next new thread, so
+// threads that come and go don't add up to more shards than ever ran at
+// once. Shards come from malloc and are never freed: taking one must not
+// reach operator new, which counts allocations into it.
+struct MetricsShard {
+    std::array<LatencyHistogram, stageCount> stages {};
+    std::array<std::atomic<uint64_t>, counterCount> counters {};
+    std::atomic<bool> isTaken {true};
+    MetricsShard* next = nullptr;
+};
+
+// The process-wide metrics: the sum over all shards, plus the console
+// transitions, which only the console thread records.
+struct Metrics {
+    static inline std::atomic<MetricsShard*> shards {nullptr};
+    static inline std::array<std::array<std::atomic<uint64_t>, maximalStateCount>, maximalStateCount> transitions {};
+    // Atomic because the SIGUSR1 dump thread may already be reading them
+    // when the console names its states.
+    static inline std::array<std::atomic<const char*>, maximalStateCount> stateNames {};
+    // 0, until a dump is asked for, times nothing.
+    static inline std::atomic<uint64_t> samplingInterval {0};
+
+    static MetricsShard* takeShard() {
+        for (auto shard = shards.load(std::memory_order_acquire); shard != nullptr; shard = shard->next) {
+            bool isTaken = false;
+            if (shard->isTaken.compare_exchange_strong(isTaken, true, std::memory_order_acquire)) {
+                return shard;
+            }
+        }
+        void* memory = std::malloc(sizeof(MetricsShard));
+        if (memory == nullptr) {
+            std::abort();
+        }
+        auto shard = new (memory) MetricsShard();
+        shard->next = shards.load(std::memory_order_relaxed);
+        while (!shards.compare_exchange_weak(shard->next, shard, std::memory_order_release, std::memory_order_relaxed)) {}
+        return shard;
+    }
+
+    // The calling thread's shard.
+    static MetricsShard& local() {
+        struct Holder {
+            MetricsShard* shard = takeShard();
+            ~Holder() { shard->isTaken.store(false, std::memory_order_release); }
+        };
+        thread_local Holder holder;
+        return *holder.shard;
+    }
+
+    static void count(Counter counter, uint64_t amount = 1) {
+        if constexpr (instrumentationEnabled) {
+            increment(local().counters[static_cast<size_t>(counter)], amount);
+        }
+    }
+
+    static void transition(size_t from, size_t to) {
+        if constexpr (instrumentationEnabled) {
+            if (from < maximalStateCount && to < maximalStateCount) {
+                transitions[from][to].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // names[index] names the state with that index; the names must outlive
+    // the metrics.
+    template <size_t Count>
+    static void nameStates(const std::array<const char*, Count>& names) {
+        static_assert(Count <= maximalStateCount, "too many states to record transitions of");
+        if constexpr (instrumentationEnabled) {
+            for (size_t index = 0; index < Count; ++index) {
+                stateNames[index].store(names[index], std::memory_order_release);
+            }
+        }
+    }
+};
+
+// Counts a call of stage and, when it is sampled, records the time from
+// construction to destruction in the calling thread's histogram.
+class StageTimer {
+#ifdef COMPLEX_NUMBER_INSTRUMENTATION
+private:
+    LatencyHistogram& histogram;
+    bool isSampled;
+    std::chrono::steady_clock::time_point start;
+public:
+    explicit StageTimer(Stage stage): histogram(Metrics::local().stages[static_cast<size_t>(stage)]), isSampled(histogram.countCall(Metrics::samplingInterval.load(std::memory_order_relaxed))) {
+        if (isSampled) {
+            start = std::chrono::steady_clock::now();
+        }
+    };
+
+    ~StageTimer() {
+        if (isSampled) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            histogram.record(static_cast<uint64_t>(elapsed.count()));
+        }
+    }
+#else
+public:
+    explicit StageTimer(Stage) {};
+#endif
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+};
+
+// MARK: - Dumping
+
+enum class MetricsFormat {
+    JSON,
+    PROMETHEUS
+};
+
+std::string formatMetrics(MetricsFormat format);
+
+// Writes next to path and renames over it, so a reader never sees half a
+// dump. Returns false when the file can't be written.
+bool writeMetrics(const std::string& path, MetricsFormat format);
+
+// Dumps to path when the process exits normally and, where there are POSIX
+// signals, whenever it gets SIGUSR1. Call it before any thread is started:
+// the signal is blocked in the calling thread, which the others inherit,
+// and taken by a thread of its own.
+void dumpMetrics(const std::string& path, MetricsFormat format);
+
+#endif /* Instrumentation_hpp */
@@ -0,0 +1,127 @@
+//
+//  MappedFile.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <utility>
+
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// MARK: - Lifecycle
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+#if defined(_WIN32)
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+// MARK: - Mapping
+
+#if defined(_WIN32)
+
+Result<MappedFile> MappedFile::open(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return Result<MappedFile>(Error("can't open " + path));
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return Result<MappedFile>(Error("can't read the size of " + path));
+    }
+
+    MappedFile mapped;
+    if (fileSize.QuadPart > 0) {
+        mapped.mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapped.mapping != nullptr) {
+            mapped.data = static_cast<const char*>(MapViewOfFile(mapped.mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (mapped.data == nullptr) {
+            CloseHandle(file);
+            return Result<MappedFile>(Error("can't map " + path));
+        }
+        mapped.size = static_cast<size_t>(fileSize.QuadPart);
+    }
+    CloseHandle(file);
+    return Result<MappedFile>(std::move(mapped));
+}
+
+void MappedFile::unmap() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+    data = nullptr;
+    mapping = nullptr;
+    size = 0;
+}
+
+#else
+
+Result<MappedFile> MappedFile::open(const std::string& path) {
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return Result<MappedFile>(Error("can't open " + path));
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        return Result<MappedFile>(Error("can't read the size of " + path));
+    }
+
+    // An empty file can't be mapped and needs no mapping.
+    MappedFile mapped;
+    if (status.st_size > 0) {
+        void* address = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (address == MAP_FAILED) {
+            close(file);
+            return Result<MappedFile>(Error("can't map " + path));
+        }
+        madvise(address, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+        mapped.data = static_cast<const char*>(address);
+        mapped.size = static_cast<size_t>(status.st_size);
+    }
+    close(file);
+    return Result<MappedFile>(std::move(mapped));
+}
+
+void MappedFile::unmap() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+}
+
+#endif
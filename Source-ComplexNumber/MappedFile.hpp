@@ -0,0 +1,41 @@
+//
+//  MappedFile.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef MappedFile_hpp
+#define MappedFile_hpp
+
+#include <string>
+#include <string_view>
+
+#include "Result.hpp"
+
+// Read-only memory mapping of a whole file. contents() views the pages
+// directly: nothing is read or copied until a byte is touched. Move-only;
+// the mapping goes away with the last owner, and views into it with it.
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    void* mapping = nullptr;
+#endif
+
+    MappedFile() {};
+    void unmap();
+public:
+    static Result<MappedFile> open(const std::string& path);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    std::string_view contents() const { return std::string_view(data, size); }
+};
+
+#endif /* MappedFile_hpp */
@@ -0,0 +1,136 @@
+//
+//  Pipeline.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <thread>
+
+#include "Pipeline.hpp"
+
+template <typename Scalar>
+Pipeline<Scalar>::Pipeline(size_t chunkLines, size_t chunkCount): chunkLines(chunkLines), chunkCount(chunkCount), lexQueue(chunkCount), parseQueue(chunkCount), computeQueue(chunkCount), formatQueue(chunkCount), recycleQueue(chunkCount) {};
+
+// MARK: - Stages
+
+template <typename Scalar>
+void Pipeline<Scalar>::read(std::istream& input) {
+    size_t allocated = 0;
+    std::string line;
+    bool hasInput = true;
+
+    while (hasInput) {
+        ChunkPointer chunk;
+        if (!recycleQueue.tryPop(chunk)) {
+            if (allocated < chunkCount) {
+                chunk = std::make_unique<Chunk>();
+                allocated += 1;
+            } else {
+                recycleQueue.pop(chunk);
+            }
+        }
+
+        chunk->text.clear();
+        chunk->lines.clear();
+        while (chunk->lines.size() < chunkLines && (hasInput = static_cast<bool>(std::getline(input, line)))) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            chunk->lines.emplace_back(chunk->text.size(), line.size());
+            chunk->text += line;
+        }
+
+        if (!chunk->lines.empty()) {
+            lexQueue.push(std::move(chunk));
+        }
+    }
+    lexQueue.close();
+}
+
+template <typename Scalar>
+void Pipeline<Scalar>::lex() {
+    Tokenizer tokenizer;
+    ChunkPointer chunk;
+
+    while (lexQueue.pop(chunk)) {
+        chunk->tokens.clear();
+        chunk->arena.reset();
+        for (size_t index = 0; index < chunk->lines.size(); ++index) {
+            chunk->tokens.push_back(tokenizer.tokenize(chunk->line(index), chunk->arena.resource()));
+        }
+        parseQueue.push(std::move(chunk));
+    }
+    parseQueue.close();
+}
+
+template <typename Scalar>
+void Pipeline<Scalar>::parse() {
+    BasicBatchEvaluator<Scalar> evaluator (0);
+    ChunkPointer chunk;
+
+    while (parseQueue.pop(chunk)) {
+        chunk->jobs.clear();
+        for (const auto& tokens: chunk->tokens) {
+            chunk->jobs.push_back(evaluator.parse(tokens));
+        }
+        computeQueue.push(std::move(chunk));
+    }
+    computeQueue.close();
+}
+
+template <typename Scalar>
+void Pipeline<Scalar>::compute() {
+    ChunkPointer chunk;
+
+    while (computeQueue.pop(chunk)) {
+        chunk->values.clear();
+        for (const auto& job: chunk->jobs) {
+            chunk->values.push_back(job.and_then(calculate<Scalar>));
+        }
+        formatQueue.push(std::move(chunk));
+    }
+    formatQueue.close();
+}
+
+template <typename Scalar>
+void Pipeline<Scalar>::format(std::ostream& output) {
+    std::string buffer;
+    buffer.reserve(batchOutputBlock + 256);
+    ChunkPointer chunk;
+
+    while (formatQueue.pop(chunk)) {
+        for (auto& value: chunk->values) {
+            appendResult(buffer, value);
+            if (buffer.size() >= batchOutputBlock) {
+                output.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        recycleQueue.push(std::move(chunk));
+    }
+
+    output.write(buffer.data(), buffer.size());
+    output.flush();
+}
+
+// MARK: - Running
+
+template <typename Scalar>
+void Pipeline<Scalar>::run(std::istream& input, std::ostream& output) {
+    std::thread lexer ([this] { lex(); });
+    std::thread parser ([this] { parse(); });
+    std::thread calculator ([this] { compute(); });
+    std::thread formatter ([this, &output] { format(output); });
+
+    read(input);
+
+    lexer.join();
+    parser.join();
+    calculator.join();
+    formatter.join();
+}
+
+template class Pipeline<float>;
+template class Pipeline<double>;
+template class Pipeline<long double>;
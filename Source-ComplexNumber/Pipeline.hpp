@@ -0,0 +1,73 @@
+//
+//  Pipeline.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef Pipeline_hpp
+#define Pipeline_hpp
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Batch.hpp"
+#include "RequestArena.hpp"
+#include "SpscQueue.hpp"
+#include "Tokenizer.hpp"
+
+// Batch evaluation of "operand operation operand" lines as a chain of
+// stages, each on its own thread:
+//   read (caller) -> lex -> parse -> compute -> format/write
+// Lines travel in chunks through bounded SpscQueues, so stages overlap and
+// output keeps the input order. Only a fixed number of chunks exists;
+// the formatter hands finished ones back to the reader, which waits when
+// none is free, and that holds back input when a later stage is slower.
+template <typename Scalar>
+class Pipeline {
+private:
+    // A chunk's token lists live in its own arena, which the lexer resets
+    // when the chunk comes back around.
+    struct Chunk {
+        std::string text;
+        std::vector<std::pair<size_t, size_t>> lines;
+        RequestArena arena = RequestArena(256 << 10);
+        std::vector<TokenList> tokens;
+        std::vector<Result<BasicCalculationJob<Scalar>>> jobs;
+        std::vector<Result<BasicBatchValue<Scalar>>> values;
+
+        std::string_view line(size_t index) const {
+            return std::string_view(text).substr(lines[index].first, lines[index].second);
+        }
+    };
+
+    typedef std::unique_ptr<Chunk> ChunkPointer;
+
+    size_t chunkLines;
+    size_t chunkCount;
+    SpscQueue<ChunkPointer> lexQueue;
+    SpscQueue<ChunkPointer> parseQueue;
+    SpscQueue<ChunkPointer> computeQueue;
+    SpscQueue<ChunkPointer> formatQueue;
+    SpscQueue<ChunkPointer> recycleQueue;
+
+    void read(std::istream& input);
+    void lex();
+    void parse();
+    void compute();
+    void format(std::ostream& output);
+public:
+    explicit Pipeline(size_t chunkLines = 1024, size_t chunkCount = 8);
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Single use: every run closes the queues behind it.
+    void run(std::istream& input, std::ostream& output);
+};
+
+#endif /* Pipeline_hpp */
@@ -0,0 +1,172 @@
+//
+//  PolarKernels.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef PolarKernels_hpp
+#define PolarKernels_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// Scalar building blocks of modulus and argument, shared by ComplexNumber
+// and the SIMD kernels of ComplexArray.cpp, which repeat them lane by lane.
+
+// MARK: - Modulus Scaling
+
+// 2^exponent, exact for every exponent Scalar can represent.
+template <typename Scalar>
+constexpr Scalar powerOfTwo(int exponent) noexcept {
+    Scalar result = 1;
+    Scalar base = exponent < 0 ? Scalar(0.5) : Scalar(2);
+    for (unsigned remaining = exponent < 0 ? -exponent : exponent; remaining > 0; remaining >>= 1) {
+        if (remaining & 1) {
+            result *= base;
+        }
+        if (remaining > 1) {
+            base *= base;
+        }
+    }
+    return result;
+}
+
+// Bounds and power-of-two factors for modulus. A sum of squares between
+// smallestSum and max() is accurate as it is (a subnormal square is too
+// small to matter there). Otherwise parts whose largest magnitude is above
+// upper are multiplied by shrink, below lower by grow, so their squares
+// neither overflow nor drop into the subnormal range. Applying and undoing
+// a power of two is exact.
+template <typename Scalar>
+struct ModulusScaling {
+    typedef std::numeric_limits<Scalar> Limits;
+
+    static constexpr Scalar smallestSum = powerOfTwo<Scalar>(Limits::min_exponent + Limits::digits);
+
+    static constexpr Scalar upper = powerOfTwo<Scalar>(Limits::max_exponent / 2 - 1);
+    static constexpr Scalar shrink = powerOfTwo<Scalar>(-(Limits::max_exponent / 2 + 1));
+    static constexpr Scalar shrinkInverse = powerOfTwo<Scalar>(Limits::max_exponent / 2 + 1);
+    static constexpr Scalar lower = powerOfTwo<Scalar>(Limits::min_exponent / 2);
+    static constexpr Scalar grow = powerOfTwo<Scalar>(-(Limits::min_exponent / 2) + Limits::digits);
+    static constexpr Scalar growInverse = powerOfTwo<Scalar>(Limits::min_exponent / 2 - Limits::digits);
+};
+
+// MARK: - Argument
+
+// Accuracy of the argument kernels; all of them keep atan2 semantics and
+// are branch free. The error bounds are absolute, in radians.
+enum class ArgumentAccuracy {
+    FULL,       // cephes atan rational approximation, within 2 ULP of
+                // std::atan2
+    FAST,       // degree 15 minimax polynomial, 4e-8
+    COARSE      // degree 7 minimax polynomial, 9e-5
+};
+
+// Arctangent approximation.
+//
+// Every argument kernel works on the ratio of the smaller to the larger
+// magnitude, so atan is only needed on [0, 1]; atan2 follows from
+// pi/2 - atan(r) when the imaginary part is larger, pi - angle for a
+// negative real part and the sign of the imaginary part.
+//
+// FULL is the rational approximation from cephes atan, with [0.66, 1]
+// reduced through atan(x) = pi/4 + atan((x-1)/(x+1)). FAST and COARSE are
+// odd minimax polynomials x*P(x^2) fitted to atan on [0, 1].
+
+inline constexpr double atanP[] = {
+    -8.750608600031904122785E-1,
+    -1.615753718733365076637E1,
+    -7.500855792314704667340E1,
+    -1.228866684490136173410E2,
+    -6.485021904942025371773E1
+};
+inline constexpr double atanQ[] = {
+    2.485846490142306297962E1,
+    1.650270098316988542046E2,
+    4.328810604912902668951E2,
+    4.853903996359136964868E2,
+    1.945506571482613964425E2
+};
+inline constexpr double atanMoreBits = 6.123233995736765886130E-17;
+
+// Highest power first, for Horner's scheme.
+inline constexpr double atanFast[] = {
+    -4.05456705498405227e-03,
+    2.18629577547119307e-02,
+    -5.59123274793318567e-02,
+    9.64219747036098584e-02,
+    -1.39086296570632928e-01,
+    1.99465656886781001e-01,
+    -3.33298607900279653e-01,
+    9.99999335581073012e-01
+};
+inline constexpr double atanCoarse[] = {
+    -3.89865102157662610e-02,
+    1.46264459554049098e-01,
+    -3.21174969709254965e-01,
+    9.99213813257237238e-01
+};
+
+template <size_t degree>
+inline double atanPolynomialScalar(const double (&coefficients)[degree], double x) {
+    const double square = x*x;
+    double polynomial = coefficients[0];
+    for (size_t index = 1; index < degree; ++index) {
+        polynomial = polynomial*square + coefficients[index];
+    }
+    return x*polynomial;
+}
+
+// atan on [0, 1].
+template <ArgumentAccuracy accuracy>
+inline double atanUnitScalar(double x) {
+    if constexpr (accuracy == ArgumentAccuracy::FULL) {
+        const bool isMiddle = x > 0.66;
+        const double reduced = isMiddle ? (x - 1.0)/(x + 1.0) : x;
+        const double offset = isMiddle ? 0.785398163397448309615660845819875721 : 0.0;
+        const double moreBits = isMiddle ? 0.5*atanMoreBits : 0.0;
+
+        const double square = reduced*reduced;
+        double numerator = atanP[0];
+        for (int index = 1; index < 5; ++index) {
+            numerator = numerator*square + atanP[index];
+        }
+        double denominator = square + atanQ[0];
+        for (int index = 1; index < 5; ++index) {
+            denominator = denominator*square + atanQ[index];
+        }
+
+        double tail = square*numerator/denominator;
+        tail = reduced*tail + reduced;
+        return offset + (tail + moreBits);
+    } else if constexpr (accuracy == ArgumentAccuracy::FAST) {
+        return atanPolynomialScalar(atanFast, x);
+    } else {
+        return atanPolynomialScalar(atanCoarse, x);
+    }
+}
+
+// Selections rather than branches; the SIMD versions in ComplexArray.cpp
+// do the same operations lane by lane.
+template <ArgumentAccuracy accuracy>
+inline double atan2Scalar(double imaginary, double real) {
+    const double pi = 3.141592653589793238462643383279502884;
+    const double realMagnitude = std::fabs(real);
+    const double imaginaryMagnitude = std::fabs(imaginary);
+    const double largest = realMagnitude > imaginaryMagnitude ? realMagnitude : imaginaryMagnitude;
+    const double smallest = realMagnitude < imaginaryMagnitude ? realMagnitude : imaginaryMagnitude;
+
+    double ratio = smallest/largest;
+    ratio = largest == 0.0 ? 0.0 : ratio;
+    ratio = smallest == std::numeric_limits<double>::infinity() ? 1.0 : ratio;
+
+    double angle = atanUnitScalar<accuracy>(ratio);
+    angle = imaginaryMagnitude > realMagnitude ? pi/2 - angle : angle;
+    angle = std::signbit(real) ? pi - angle : angle;
+    angle = std::copysign(angle, imaginary);
+    return std::isnan(real) || std::isnan(imaginary) ? std::numeric_limits<double>::quiet_NaN() : angle;
+}
+
+#endif /* PolarKernels_hpp */
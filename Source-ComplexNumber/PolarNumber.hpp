@@ -0,0 +1,274 @@
+//
+//  PolarNumber.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef PolarNumber_hpp
+#define PolarNumber_hpp
+
+#include <cmath>
+#include <type_traits>
+
+#include "ComplexNumber.hpp"
+
+// Integer exponents up to this magnitude are raised by squaring.
+constexpr long largestSquaringExponent = 64;
+
+// Square and multiply, for a scalar or a complex base. On a complex one it
+// is exact for Gaussian integers, and a handful of cartesian multiplies
+// beats converting to polar and back.
+template <typename Value>
+constexpr Value integerPower(Value base, long exponent) noexcept {
+    Value result (1);
+    const bool isInverse = exponent < 0;
+    unsigned long remaining = isInverse ? -static_cast<unsigned long>(exponent) : exponent;
+    while (remaining != 0) {
+        if (remaining & 1) {
+            result *= base;
+        }
+        remaining >>= 1;
+        if (remaining != 0) {
+            base *= base;
+        }
+    }
+    return isInverse ? Value(1) / result : result;
+}
+
+// The range is checked before the cast to long, which is undefined for
+// NaN, infinities and anything out of long's range; NaN fails both
+// comparisons.
+template <typename Scalar>
+constexpr bool isSquaringExponent(Scalar exponent) noexcept {
+    return exponent <= largestSquaringExponent && exponent >= -largestSquaringExponent && exponent == static_cast<long>(exponent);
+}
+
+// Modulus and angle. A product, a quotient or a power is one multiply (or
+// pow) and one add, where the cartesian form needs four multiplies, Smith's
+// divisions or repeated squaring. The angle is left unreduced as it
+// accumulates and argument() reduces it to [-pi, pi] on request. Converting
+// costs a modulus and an argument one way and a sin and a cos the other,
+// so a chain should convert once at each end: BasicLazyComplexNumber does
+// that bookkeeping.
+template <typename Scalar>
+class BasicPolarNumber {
+    static_assert(std::is_floating_point<Scalar>::value, "BasicPolarNumber needs a floating point scalar");
+private:
+    static constexpr Scalar pi = Scalar(3.141592653589793238462643383279502884L);
+
+    Scalar radius = 0;
+    Scalar angle = 0;
+public:
+    constexpr Scalar getAngle() const noexcept { return angle; }
+
+    constexpr BasicPolarNumber() noexcept = default;
+    constexpr BasicPolarNumber(const Scalar radius, const Scalar angle) noexcept: radius(radius), angle(angle) {};
+    explicit BasicPolarNumber(const BasicComplexNumber<Scalar>& complex) noexcept: radius(complex.modulus()), angle(complex.argument()) {};
+
+    // The principal value of exp(exponent), which is polar without any
+    // trigonometry: e^re at an angle of im.
+    static BasicPolarNumber exponential(const BasicComplexNumber<Scalar>& exponent) noexcept {
+        return BasicPolarNumber(std::exp(exponent.getReal()), exponent.getImaginary());
+    }
+
+    BasicComplexNumber<Scalar> toCartesian() const noexcept {
+        return BasicComplexNumber<Scalar>(radius*std::cos(angle), radius*std::sin(angle));
+    }
+
+    // MARK: - Special Math Operations For Complex Numbers
+
+    constexpr Scalar modulus() const noexcept {
+        return radius;
+    }
+
+    // The angle reduced to [-pi, pi]. One already in range comes back as
+    // is, so a converted number keeps the sign atan2 gave it on the cut.
+    Scalar argument() const noexcept {
+        if (angle >= -pi && angle <= pi) {
+            return angle;
+        }
+        return std::remainder(angle, 2*pi);
+    }
+
+    // Principal values, taken on the reduced argument. Integer powers don't
+    // depend on the branch and leave the angle unreduced.
+    BasicPolarNumber power(const Scalar exponent) const noexcept {
+        if (isSquaringExponent(exponent)) {
+            return BasicPolarNumber(integerPower(radius, static_cast<long>(exponent)), angle*exponent);
+        }
+        return BasicPolarNumber(std::pow(radius, exponent), argument()*exponent);
+    }
+
+    BasicPolarNumber power(const BasicComplexNumber<Scalar>& exponent) const noexcept {
+        if (exponent.getImaginary() == 0) {
+            return power(exponent.getReal());
+        }
+        return exponential(exponent * logarithm());
+    }
+
+    BasicPolarNumber root(const Scalar degree) const noexcept {
+        return power(1/degree);
+    }
+
+    BasicComplexNumber<Scalar> logarithm() const noexcept {
+        return BasicComplexNumber<Scalar>(std::log(radius), argument());
+    }
+
+    // MARK: - Arithmetic Operations
+
+    constexpr BasicPolarNumber operator*(const BasicPolarNumber& factor) const noexcept {
+        return BasicPolarNumber(radius*factor.radius, angle + factor.angle);
+    }
+
+    constexpr BasicPolarNumber operator/(const BasicPolarNumber& divisor) const noexcept {
+        return BasicPolarNumber(radius/divisor.radius, angle - divisor.angle);
+    }
+
+    constexpr BasicPolarNumber operator-() const noexcept {
+        return BasicPolarNumber(radius, angle + pi);
+    }
+};
+
+typedef BasicPolarNumber<float> PolarNumberFloat;
+typedef BasicPolarNumber<double> PolarNumber;
+typedef BasicPolarNumber<long double> PolarNumberLongDouble;
+
+// The principal square root without trigonometry, exact where the root is:
+// sqrt(-4) is 2i.
+template <typename Scalar>
+BasicComplexNumber<Scalar> squareRoot(const BasicComplexNumber<Scalar>& complex) noexcept {
+    const Scalar real = complex.getReal();
+    const Scalar imaginary = complex.getImaginary();
+    if (real == 0 && imaginary == 0) {
+        return BasicComplexNumber<Scalar>(0, imaginary);
+    }
+    const Scalar root = std::sqrt(complex.modulus()/2 + std::fabs(real)/2);
+    if (real >= 0) {
+        return BasicComplexNumber<Scalar>(root, imaginary/(2*root));
+    }
+    return BasicComplexNumber<Scalar>(std::fabs(imaginary)/(2*root), std::copysign(root, imaginary));
+}
+
+// A complex number in the form its last operation produced, cartesian or
+// polar; the other form is computed on first use and kept. Every operation
+// picks its form from what the operands already hold:
+//   + -          cartesian
+//   * /          cartesian when both operands hold it, otherwise polar,
+//                so a chain stays polar and converts once
+//   power, root  polar, except that a number held in cartesian form is
+//                raised to a small integer power by squaring and has its
+//                square root taken directly
+//   exp          cartesian in, polar out
+//   log          polar in, cartesian out
+//   unary -, modulus, argument
+//                whichever form is held
+template <typename Scalar>
+class BasicLazyComplexNumber {
+private:
+    typedef BasicComplexNumber<Scalar> Cartesian;
+    typedef BasicPolarNumber<Scalar> Polar;
+
+    Cartesian cartesian;
+    Polar polar;
+    bool hasCartesian = true;
+    bool hasPolar = false;
+public:
+    constexpr BasicLazyComplexNumber() noexcept = default;
+    constexpr BasicLazyComplexNumber(const Cartesian& cartesian) noexcept: cartesian(cartesian), hasCartesian(true), hasPolar(false) {};
+    constexpr BasicLazyComplexNumber(const Polar& polar) noexcept: polar(polar), hasCartesian(false), hasPolar(true) {};
+
+    constexpr bool isCartesian() const noexcept { return hasCartesian; }
+    constexpr bool isPolar() const noexcept { return hasPolar; }
+
+    const Cartesian& cartesianForm() noexcept {
+        if (!hasCartesian) {
+            cartesian = polar.toCartesian();
+            hasCartesian = true;
+        }
+        return cartesian;
+    }
+
+    const Polar& polarForm() noexcept {
+        if (!hasPolar) {
+            polar = Polar(cartesian);
+            hasPolar = true;
+        }
+        return polar;
+    }
+
+    // MARK: - Special Math Operations For Complex Numbers
+
+    Scalar modulus() const noexcept {
+        return hasPolar ? polar.modulus() : cartesian.modulus();
+    }
+
+    Scalar argument() const noexcept {
+        return hasPolar ? polar.argument() : cartesian.argument();
+    }
+
+    // A real exponent, i.e. one with a zero imaginary part, uses pow.
+    BasicLazyComplexNumber power(BasicLazyComplexNumber exponent) {
+        const Cartesian& value = exponent.cartesianForm();
+        if (hasCartesian && value.getImaginary() == 0 && isSquaringExponent(value.getReal())) {
+            return integerPower(cartesian, static_cast<long>(value.getReal()));
+        }
+        return polarForm().power(value);
+    }
+
+    BasicLazyComplexNumber root(BasicLazyComplexNumber degree) {
+        const Cartesian& value = degree.cartesianForm();
+        if (value.getImaginary() != 0) {
+            return polarForm().power(Cartesian(1) / value);
+        }
+        if (hasCartesian && value.getReal() == 2) {
+            return squareRoot(cartesian);
+        }
+        return polarForm().root(value.getReal());
+    }
+
+    BasicLazyComplexNumber exponential() {
+        return Polar::exponential(cartesianForm());
+    }
+
+    BasicLazyComplexNumber logarithm() {
+        return polarForm().logarithm();
+    }
+
+    // MARK: - Arithmetic Operations
+
+    friend BasicLazyComplexNumber operator+(BasicLazyComplexNumber first, BasicLazyComplexNumber second) {
+        return first.cartesianForm() + second.cartesianForm();
+    }
+
+    friend BasicLazyComplexNumber operator-(BasicLazyComplexNumber first, BasicLazyComplexNumber second) {
+        return first.cartesianForm() - second.cartesianForm();
+    }
+
+    friend BasicLazyComplexNumber operator*(BasicLazyComplexNumber first, BasicLazyComplexNumber second) {
+        if (first.hasCartesian && second.hasCartesian) {
+            return first.cartesian * second.cartesian;
+        }
+        return first.polarForm() * second.polarForm();
+    }
+
+    friend BasicLazyComplexNumber operator/(BasicLazyComplexNumber first, BasicLazyComplexNumber second) {
+        if (first.hasCartesian && second.hasCartesian) {
+            return first.cartesian / second.cartesian;
+        }
+        return first.polarForm() / second.polarForm();
+    }
+
+    BasicLazyComplexNumber operator-() const noexcept {
+        BasicLazyComplexNumber negated = *this;
+        negated.cartesian = -cartesian;
+        negated.polar = -polar;
+        return negated;
+    }
+};
+
+typedef BasicLazyComplexNumber<float> LazyComplexNumberFloat;
+typedef BasicLazyComplexNumber<double> LazyComplexNumber;
+typedef BasicLazyComplexNumber<long double> LazyComplexNumberLongDouble;
+
+#endif /* PolarNumber_hpp */
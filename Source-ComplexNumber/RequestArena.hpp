@@ -0,0 +1,37 @@
+//
+//  RequestArena.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef RequestArena_hpp
+#define RequestArena_hpp
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Monotonic arena for the containers of one request (one input line): the
+// tokens and everything the flows derive from them. Allocating bumps a
+// pointer, freeing does nothing, and reset() drops everything at once.
+// The first block belongs to the arena and is reused after each reset, so
+// a request that fits in it never reaches the global allocator; a bigger
+// one spills over to it until the next reset. Containers allocated here
+// must be gone, or at least unused, before reset().
+class RequestArena {
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    std::pmr::monotonic_buffer_resource arena;
+public:
+    explicit RequestArena(size_t size = 16 << 10): buffer(new std::byte[size]), arena(buffer.get(), size, std::pmr::new_delete_resource()) {};
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &arena; }
+
+    void reset() { arena.release(); }
+};
+
+#endif /* RequestArena_hpp */
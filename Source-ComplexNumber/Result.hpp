@@ -11,39 +11,113 @@
 #include <variant>
 #include <string>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 struct Error {
     std::string description;
-    Error(std::string description) {
-        this->description = description;
-    }
+    std::optional<size_t> position;
+    Error(std::string description, std::optional<size_t> position = std::nullopt): description(std::move(description)), position(position) {};
 };
 
+template <typename Success>
+class Result;
+
+template <typename T>
+struct IsResult: std::false_type {};
+
+template <typename Success>
+struct IsResult<Result<Success>>: std::true_type {};
+
+// Either a value or an Error, in the spirit of std::expected. Checks are
+// holds_alternative, accessors return references and never throw: calling
+// success() on an error (or error() on a success) is a precondition
+// violation, so check hasSuccess()/hasError() first.
 template <typename Success>
 class Result {
 private:
     std::variant<Success, Error> result;
 public:
-    Result(std::variant<Success, Error> result): result(result) {};
-    
-    std::optional<Success> success() {
-        try {
-            auto success = std::get<Success>(result);
-            return success;
+    Result(std::variant<Success, Error> result): result(std::move(result)) {};
+
+    bool hasSuccess() const noexcept {
+        return std::holds_alternative<Success>(result);
+    }
+
+    bool hasError() const noexcept {
+        return std::holds_alternative<Error>(result);
+    }
+
+    explicit operator bool() const noexcept {
+        return hasSuccess();
+    }
+
+    Success& success() & noexcept {
+        return *std::get_if<Success>(&result);
+    }
+
+    const Success& success() const & noexcept {
+        return *std::get_if<Success>(&result);
+    }
+
+    Success&& success() && noexcept {
+        return std::move(*std::get_if<Success>(&result));
+    }
+
+    Error& error() & noexcept {
+        return *std::get_if<Error>(&result);
+    }
+
+    const Error& error() const & noexcept {
+        return *std::get_if<Error>(&result);
+    }
+
+    Error&& error() && noexcept {
+        return std::move(*std::get_if<Error>(&result));
+    }
+
+    // next(Success) -> Result<Other>; an error is passed through untouched.
+    template <typename Next>
+    auto and_then(Next&& next) && {
+        typedef std::invoke_result_t<Next, Success&&> Chained;
+        static_assert(IsResult<Chained>::value, "and_then expects a function returning a Result");
+
+        if (hasSuccess()) {
+            return std::forward<Next>(next)(std::move(*this).success());
         }
-        catch (std::bad_variant_access) {
-            return std::nullopt;
+        return Chained(std::move(*this).error());
+    }
+
+    template <typename Next>
+    auto and_then(Next&& next) const & {
+        typedef std::invoke_result_t<Next, const Success&> Chained;
+        static_assert(IsResult<Chained>::value, "and_then expects a function returning a Result");
+
+        if (hasSuccess()) {
+            return std::forward<Next>(next)(success());
         }
+        return Chained(error());
     }
 
-    std::optional<Error> error() {
-        try {
-            auto error = std::get<Error>(result);
-            return error;
+    // map(Success) -> Other, wrapped into Result<Other>.
+    template <typename Map>
+    auto transform(Map&& map) && {
+        typedef Result<std::decay_t<std::invoke_result_t<Map, Success&&>>> Mapped;
+
+        if (hasSuccess()) {
+            return Mapped(std::forward<Map>(map)(std::move(*this).success()));
         }
-        catch (std::bad_variant_access) {
-            return std::nullopt;
+        return Mapped(std::move(*this).error());
+    }
+
+    template <typename Map>
+    auto transform(Map&& map) const & {
+        typedef Result<std::decay_t<std::invoke_result_t<Map, const Success&>>> Mapped;
+
+        if (hasSuccess()) {
+            return Mapped(std::forward<Map>(map)(success()));
         }
+        return Mapped(error());
     }
 };
 
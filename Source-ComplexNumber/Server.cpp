@@ -0,0 +1,529 @@
+//
+//  Server.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <charconv>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Server.hpp"
+#include "ThreadPool.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// MARK: - Evaluation
+
+typedef std::function<void(std::string_view lines, std::string& output)> LinesEvaluator;
+
+// Idle evaluators; a task takes one for its lines and gives it back, so
+// there are never more than tasks running at once and each keeps its
+// cache warm for the next.
+template <typename Evaluator>
+class EvaluatorPool {
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Evaluator>> idle;
+    size_t cacheCapacity;
+public:
+    explicit EvaluatorPool(size_t cacheCapacity): cacheCapacity(cacheCapacity) {};
+
+    std::unique_ptr<Evaluator> take() {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            if (!idle.empty()) {
+                auto evaluator = std::move(idle.back());
+                idle.pop_back();
+                return evaluator;
+            }
+        }
+        return std::make_unique<Evaluator>(cacheCapacity);
+    }
+
+    void give(std::unique_ptr<Evaluator> evaluator) {
+        std::lock_guard<std::mutex> lock (mutex);
+        idle.push_back(std::move(evaluator));
+    }
+};
+
+template <typename Evaluator>
+LinesEvaluator makePooledEvaluator(size_t cacheCapacity) {
+    auto evaluators = std::make_shared<EvaluatorPool<Evaluator>>(cacheCapacity);
+    return [evaluators](std::string_view lines, std::string& output) {
+        auto evaluator = evaluators->take();
+        evaluateLines(lines, *evaluator, output);
+        evaluators->give(std::move(evaluator));
+    };
+}
+
+template <typename Scalar>
+LinesEvaluator makeLinesEvaluator(BatchMode mode, size_t cacheCapacity) {
+    if (mode == BatchMode::EXPRESSION) {
+        return makePooledEvaluator<BasicExpressionEvaluator<Scalar>>(cacheCapacity);
+    }
+    return makePooledEvaluator<BasicBatchEvaluator<Scalar>>(cacheCapacity);
+}
+
+LinesEvaluator makeLinesEvaluator(BatchMode mode, Precision precision, size_t cacheCapacity) {
+    switch (precision) {
+        case Precision::FLOAT:
+            return makeLinesEvaluator<float>(mode, cacheCapacity);
+        case Precision::LONG_DOUBLE:
+            return makeLinesEvaluator<long double>(mode, cacheCapacity);
+        default:
+            return makeLinesEvaluator<double>(mode, cacheCapacity);
+    }
+}
+
+#if defined(__linux__)
+
+// MARK: - Event Loop
+
+const size_t readChunkBytes = 64 << 10;
+const int eventsPerWait = 64;
+
+// Everything but work and result belongs to the loop thread. work and
+// result belong to the task while isBusy and are handed back through the
+// completed queue.
+struct Connection {
+    int descriptor;
+    std::string input;
+    std::string work;
+    std::string result;
+    std::string output;
+    size_t written = 0;
+    uint32_t events = 0;
+    bool isWatched = true;
+    bool isBusy = false;
+    bool isReadClosed = false;
+    bool isBroken = false;
+    // The rest of a line already answered as too long is being dropped.
+    bool isSkippingLine = false;
+
+    explicit Connection(int descriptor): descriptor(descriptor) {};
+
+    size_t pendingOutput() const { return output.size() - written; }
+};
+
+class ServerLoop {
+private:
+    int listener;
+    int poller;
+    int wakeup;
+    bool isTCP;
+    const std::atomic<bool>& stopping;
+    LinesEvaluator evaluate;
+    std::unordered_map<int, std::shared_ptr<Connection>> connections;
+    std::mutex completedMutex;
+    std::vector<std::shared_ptr<Connection>> completed;
+    std::unique_ptr<ThreadPool> pool;
+
+    void accept();
+    void read(Connection& connection);
+    void flush(Connection& connection);
+    void dispatch(const std::shared_ptr<Connection>& connection);
+    void collect();
+    void update(Connection& connection);
+    void close(Connection& connection);
+public:
+    ServerLoop(int listener, int poller, int wakeup, bool isTCP, const std::atomic<bool>& stopping, LinesEvaluator evaluate, size_t threadCount): listener(listener), poller(poller), wakeup(wakeup), isTCP(isTCP), stopping(stopping), evaluate(std::move(evaluate)), pool(std::make_unique<ThreadPool>(threadCount)) {};
+
+    // Tasks still running finish before the connections go.
+    ~ServerLoop() {
+        pool.reset();
+        for (auto& entry: connections) {
+            ::close(entry.first);
+        }
+    }
+
+    void run();
+};
+
+void ServerLoop::run() {
+    epoll_event events[eventsPerWait];
+    while (!stopping) {
+        int count = epoll_wait(poller, events, eventsPerWait, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        for (int index = 0; index < count; ++index) {
+            int descriptor = events[index].data.fd;
+            if (descriptor == listener) {
+                accept();
+                continue;
+            }
+            if (descriptor == wakeup) {
+                collect();
+                continue;
+            }
+
+            auto entry = connections.find(descriptor);
+            if (entry == connections.end()) {
+                continue;
+            }
+            auto connection = entry->second;
+            uint32_t happened = events[index].events;
+            if (happened & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                read(*connection);
+            }
+            if (happened & (EPOLLHUP | EPOLLERR)) {
+                // Nobody left to answer.
+                connection->isBroken = true;
+            }
+            if (happened & EPOLLOUT) {
+                flush(*connection);
+            }
+            dispatch(connection);
+            update(*connection);
+        }
+    }
+}
+
+void ServerLoop::accept() {
+    while (true) {
+        int descriptor = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (descriptor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;
+        }
+        if (isTCP) {
+            // Answers are short and clients pipeline: don't hold them back.
+            int enabled = 1;
+            setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        }
+
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = descriptor;
+        if (epoll_ctl(poller, EPOLL_CTL_ADD, descriptor, &event) != 0) {
+            ::close(descriptor);
+            continue;
+        }
+        auto connection = std::make_shared<Connection>(descriptor);
+        connection->events = EPOLLIN;
+        connections[descriptor] = std::move(connection);
+    }
+}
+
+// Until the socket runs dry or enough input is waiting; the level-triggered
+// poll brings the loop back for the rest.
+void ServerLoop::read(Connection& connection) {
+    char buffer[readChunkBytes];
+    while (!connection.isReadClosed && !connection.isBroken && connection.input.size() < serverPendingBytes) {
+        ssize_t count = recv(connection.descriptor, buffer, sizeof(buffer), 0);
+        if (count > 0) {
+            connection.input.append(buffer, count);
+        } else if (count == 0) {
+            connection.isReadClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            connection.isBroken = errno != EAGAIN && errno != EWOULDBLOCK;
+            return;
+        }
+    }
+}
+
+void ServerLoop::flush(Connection& connection) {
+    while (connection.pendingOutput() > 0 && !connection.isBroken) {
+        ssize_t count = send(connection.descriptor, connection.output.data() + connection.written, connection.pendingOutput(), MSG_NOSIGNAL);
+        if (count > 0) {
+            connection.written += count;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else {
+            connection.isBroken = count < 0 && errno != EAGAIN && errno != EWOULDBLOCK;
+            return;
+        }
+    }
+    connection.output.clear();
+    connection.written = 0;
+}
+
+// Hands the complete lines received so far, or the unterminated last one
+// once the client has finished, to a worker. A line that fills the input
+// without ending is answered with an error and dropped up to its end.
+void ServerLoop::dispatch(const std::shared_ptr<Connection>& connection) {
+    auto& input = connection->input;
+    if (connection->isSkippingLine) {
+        size_t end = input.find('\n');
+        connection->isSkippingLine = end == std::string::npos;
+        input.erase(0, connection->isSkippingLine ? input.size() : end + 1);
+    }
+    if (connection->isBusy || connection->isBroken || input.empty() || connection->pendingOutput() >= serverPendingBytes) {
+        return;
+    }
+
+    if (input.size() >= serverPendingBytes && input.find('\n') == std::string::npos) {
+        // Nothing is in flight, so this answer is in order.
+        connection->output += "error: line too long\n";
+        input.clear();
+        connection->isSkippingLine = true;
+        return;
+    }
+
+    size_t end = input.size() > serverBatchBytes ? input.rfind('\n', serverBatchBytes - 1) : input.rfind('\n');
+    if (end == std::string::npos) {
+        end = input.find('\n');
+    }
+    size_t length = end != std::string::npos ? end + 1 : connection->isReadClosed ? input.size() : 0;
+    if (length == 0) {
+        return;
+    }
+
+    connection->work.assign(input, 0, length);
+    input.erase(0, length);
+    connection->isBusy = true;
+    pool->submit([this, connection]() {
+        connection->result.clear();
+        evaluate(connection->work, connection->result);
+        {
+            std::lock_guard<std::mutex> lock (completedMutex);
+            completed.push_back(connection);
+        }
+        uint64_t one = 1;
+        while (write(wakeup, &one, sizeof(one)) < 0 && errno == EINTR) {}
+    });
+}
+
+void ServerLoop::collect() {
+    uint64_t count;
+    while (::read(wakeup, &count, sizeof(count)) < 0 && errno == EINTR) {}
+
+    std::vector<std::shared_ptr<Connection>> finished;
+    {
+        std::lock_guard<std::mutex> lock (completedMutex);
+        finished.swap(completed);
+    }
+    for (auto& connection: finished) {
+        connection->isBusy = false;
+        if (connection->pendingOutput() == 0) {
+            connection->output.swap(connection->result);
+            connection->written = 0;
+        } else {
+            connection->output += connection->result;
+        }
+        flush(*connection);
+        dispatch(connection);
+        update(*connection);
+    }
+}
+
+// Closes a connection with nothing left to do, or polls it for what it
+// waits on: more input while there is room for it, the socket draining
+// while answers are pending.
+void ServerLoop::update(Connection& connection) {
+    bool isDone = connection.isReadClosed && connection.input.empty() && connection.pendingOutput() == 0;
+    if (!connection.isBusy && (connection.isBroken || isDone)) {
+        close(connection);
+        return;
+    }
+    if (connection.isBroken) {
+        // Its task is still running: stop polling a socket that would
+        // report the hang-up over and over.
+        if (connection.isWatched) {
+            epoll_ctl(poller, EPOLL_CTL_DEL, connection.descriptor, nullptr);
+            connection.isWatched = false;
+        }
+        return;
+    }
+
+    uint32_t events = 0;
+    if (!connection.isReadClosed && connection.input.size() < serverPendingBytes) {
+        events |= EPOLLIN;
+    }
+    if (connection.pendingOutput() > 0) {
+        events |= EPOLLOUT;
+    }
+    if (events != connection.events) {
+        epoll_event event {};
+        event.events = events;
+        event.data.fd = connection.descriptor;
+        epoll_ctl(poller, EPOLL_CTL_MOD, connection.descriptor, &event);
+        connection.events = events;
+    }
+}
+
+void ServerLoop::close(Connection& connection) {
+    int descriptor = connection.descriptor;
+    if (connection.isWatched) {
+        epoll_ctl(poller, EPOLL_CTL_DEL, descriptor, nullptr);
+    }
+    ::close(descriptor);
+    connections.erase(descriptor);
+}
+
+// MARK: - Server
+
+Error systemError(const std::string& what) {
+    return Error(what + ": " + std::strerror(errno));
+}
+
+Result<std::string> Server::listen(const std::string& address) {
+    typedef Result<std::string> AddressResult;
+    if (listener >= 0) {
+        return AddressResult(Error("already listening"));
+    }
+
+    std::string bound;
+    const bool isTCP = address.rfind("tcp:", 0) == 0;
+    if (isTCP) {
+        unsigned short port = 0;
+        auto first = address.data() + 4;
+        auto last = address.data() + address.size();
+        auto parsed = std::from_chars(first, last, port);
+        if (first == last || parsed.ec != std::errc() || parsed.ptr != last) {
+            return AddressResult(Error("invalid port in " + address));
+        }
+
+        listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0) {
+            return AddressResult(systemError("can't create a socket"));
+        }
+        int enabled = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+
+        sockaddr_in socketAddress {};
+        socketAddress.sin_family = AF_INET;
+        socketAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socketAddress.sin_port = htons(port);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0) {
+            auto error = systemError("can't bind " + address);
+            close();
+            return AddressResult(error);
+        }
+        socklen_t length = sizeof(socketAddress);
+        getsockname(listener, reinterpret_cast<sockaddr*>(&socketAddress), &length);
+        bound = "tcp:" + std::to_string(ntohs(socketAddress.sin_port));
+    } else {
+        sockaddr_un socketAddress {};
+        if (address.empty() || address.size() >= sizeof(socketAddress.sun_path)) {
+            return AddressResult(Error("socket path too long or empty: " + address));
+        }
+        socketAddress.sun_family = AF_UNIX;
+        std::memcpy(socketAddress.sun_path, address.c_str(), address.size() + 1);
+
+        // A socket left behind by a server that is gone refuses connections
+        // and is replaced; one that accepts them belongs to a running server.
+        struct stat status;
+        if (stat(address.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+            int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (probe < 0) {
+                return AddressResult(systemError("can't create a socket"));
+            }
+            bool isConnected = connect(probe, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) == 0;
+            bool isStale = !isConnected && errno == ECONNREFUSED;
+            ::close(probe);
+            if (isConnected) {
+                return AddressResult(Error("address in use: " + address));
+            }
+            if (isStale) {
+                unlink(address.c_str());
+            }
+        }
+
+        listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0) {
+            return AddressResult(systemError("can't create a socket"));
+        }
+        if (bind(listener, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0) {
+            auto error = systemError("can't bind " + address);
+            close();
+            return AddressResult(error);
+        }
+        socketPath = address;
+        bound = address;
+    }
+
+    if (::listen(listener, SOMAXCONN) != 0) {
+        auto error = systemError("can't listen on " + address);
+        close();
+        return AddressResult(error);
+    }
+
+    poller = epoll_create1(EPOLL_CLOEXEC);
+    wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (poller < 0 || wakeup < 0) {
+        auto error = systemError("can't set up polling");
+        close();
+        return AddressResult(error);
+    }
+    for (int descriptor: {listener, wakeup}) {
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = descriptor;
+        epoll_ctl(poller, EPOLL_CTL_ADD, descriptor, &event);
+    }
+    return AddressResult(bound);
+}
+
+void Server::run() {
+    if (listener < 0) {
+        return;
+    }
+    ServerLoop loop (listener, poller, wakeup, socketPath.empty(), stopping, makeLinesEvaluator(mode, precision, cacheCapacity), threadCount);
+    loop.run();
+}
+
+void Server::stop() {
+    stopping = true;
+    if (wakeup >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeup, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void Server::close() {
+    for (int* descriptor: {&listener, &poller, &wakeup}) {
+        if (*descriptor >= 0) {
+            ::close(*descriptor);
+            *descriptor = -1;
+        }
+    }
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+        socketPath.clear();
+    }
+}
+
+#else
+
+Result<std::string> Server::listen(const std::string&) {
+    return Result<std::string>(Error("server mode needs epoll, which this system doesn't have"));
+}
+
+void Server::run() {}
+
+void Server::stop() {
+    stopping = true;
+}
+
+void Server::close() {}
+
+#endif
+
+Server::~Server() {
+    close();
+}
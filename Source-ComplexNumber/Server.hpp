@@ -0,0 +1,77 @@
+//
+//  Server.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef Server_hpp
+#define Server_hpp
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Batch.hpp"
+#include "Result.hpp"
+
+// Lines evaluated as one task, and the answers (or unread lines) a
+// connection may have waiting before the server stops reading from it.
+// serverPendingBytes is also the longest line: one that reaches it without
+// a '\n' is answered "error: line too long" and skipped to its end.
+const size_t serverBatchBytes = 64 << 10;
+const size_t serverPendingBytes = 1 << 20;
+
+// Long-lived evaluator on a local socket. The protocol is --batch and
+// --eval's: a client writes lines, and gets one result line per line in the
+// same order. It can pipeline as many lines as it likes without waiting
+// for answers.
+//
+// One thread runs an epoll loop that accepts, reads and writes on
+// non-blocking sockets. The complete lines a connection has sent, up to
+// serverBatchBytes, are evaluated as one task on the worker pool. Each
+// task borrows an evaluator (tokenizer, arena, cache) that only it uses
+// meanwhile, so the core is shared without locks. A connection has one
+// task in flight at a time, which keeps its answers in order; different
+// connections are evaluated side by side.
+//
+// epoll makes this Linux only; elsewhere listen() fails.
+class Server {
+public:
+    BatchMode mode;
+    size_t cacheCapacity;
+    Precision precision = Precision::DOUBLE;
+    size_t threadCount = std::thread::hardware_concurrency();
+
+    Server(BatchMode mode = BatchMode::EXPRESSION, size_t cacheCapacity = defaultCacheCapacity): mode(mode), cacheCapacity(cacheCapacity) {};
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // address is "tcp:<port>" for the loopback interface, port 0 picking a
+    // free one, or else the path of a Unix domain socket, which replaces a
+    // stale socket there but fails with "address in use" while another
+    // server accepts on it. Returns the address actually bound.
+    Result<std::string> listen(const std::string& address);
+
+    // Serves until stop(); needs a successful listen() first. Lines not
+    // answered by then are dropped.
+    void run();
+
+    // Safe from any thread and from a signal handler.
+    void stop();
+private:
+    int listener = -1;
+    int poller = -1;
+    int wakeup = -1;
+    std::string socketPath;
+    std::atomic<bool> stopping {false};
+
+    void close();
+};
+
+#endif /* Server_hpp */
@@ -0,0 +1,113 @@
+//
+//  SpscQueue.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef SpscQueue_hpp
+#define SpscQueue_hpp
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Waits in growing steps: spinning first, then yielding the core, then
+// sleeping, so an idle stage doesn't burn a CPU its neighbours need.
+class Backoff {
+private:
+    size_t attempts = 0;
+public:
+    void wait() {
+        attempts += 1;
+        if (attempts < 64) {
+            return;
+        } else if (attempts < 1024) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+};
+
+// Bounded lock-free ring for exactly one producer and one consumer thread.
+// Each side owns one index and only reads the other's, so a push or pop is
+// one acquire load and one release store. A full queue makes push wait,
+// which is how a slow consumer holds back its producer.
+template <typename T>
+class SpscQueue {
+private:
+    static constexpr size_t cacheLine = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+    alignas(cacheLine) std::atomic<size_t> head {0};
+    alignas(cacheLine) std::atomic<size_t> tail {0};
+    alignas(cacheLine) std::atomic<bool> closed {false};
+
+    static size_t roundedCapacity(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+public:
+    // capacity is rounded up to a power of two.
+    explicit SpscQueue(size_t capacity): slots(roundedCapacity(capacity)), mask(slots.size() - 1) {};
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return slots.size(); }
+
+    // Producer side.
+    bool tryPush(T& value) {
+        auto position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == slots.size()) {
+            return false;
+        }
+        slots[position & mask] = std::move(value);
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(T value) {
+        Backoff backoff;
+        while (!tryPush(value)) {
+            backoff.wait();
+        }
+    }
+
+    // No more pushes; the consumer drains what is left.
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    // Consumer side.
+    bool tryPop(T& value) {
+        auto position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots[position & mask]);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Waits for a value; false once the queue is closed and empty.
+    bool pop(T& value) {
+        Backoff backoff;
+        while (!tryPop(value)) {
+            if (closed.load(std::memory_order_acquire)) {
+                return tryPop(value);
+            }
+            backoff.wait();
+        }
+        return true;
+    }
+};
+
+#endif /* SpscQueue_hpp */
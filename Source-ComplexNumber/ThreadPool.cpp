@@ -0,0 +1,132 @@
+//
+//  ThreadPool.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+
+const size_t minimalGrain = 256;
+const size_t chunksPerWorker = 4;
+
+// MARK: - Lifecycle
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    threadCount = std::max<size_t>(threadCount, 1);
+    for (size_t index = 0; index < threadCount; ++index) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t index = 0; index < threadCount; ++index) {
+        workers.emplace_back([this, index]() { workerLoop(index); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock (sleepMutex);
+        stopping = true;
+    }
+    sleepCondition.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+// MARK: - Scheduling
+
+// The counter goes up before the task is visible, so a thief can never take
+// it below zero; a woken worker may spin once until the push lands.
+void ThreadPool::push(size_t queueIndex, Task task) {
+    {
+        std::lock_guard<std::mutex> lock (sleepMutex);
+        queuedTasks += 1;
+    }
+    {
+        std::lock_guard<std::mutex> lock (queues[queueIndex]->mutex);
+        queues[queueIndex]->tasks.push_back(std::move(task));
+    }
+    sleepCondition.notify_one();
+}
+
+void ThreadPool::submit(Task task) {
+    push(nextQueue++ % queues.size(), std::move(task));
+}
+
+bool ThreadPool::tryRun(size_t preferredQueue) {
+    Task task;
+
+    for (size_t offset = 0; offset < queues.size() && !task; ++offset) {
+        auto& queue = *queues[(preferredQueue + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock (queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (offset == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+    queuedTasks -= 1;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t queueIndex) {
+    while (true) {
+        if (tryRun(queueIndex)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock (sleepMutex);
+        sleepCondition.wait(lock, [this]() { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeTask& body) {
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = std::max(minimalGrain, count / (queues.size() * chunksPerWorker) + 1);
+    }
+
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<size_t> remaining {chunks};
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        size_t begin = chunk * grain;
+        size_t end = std::min(count, begin + grain);
+        push(chunk % queues.size(), [&, begin, end]() {
+            body(begin, end);
+            std::lock_guard<std::mutex> lock (doneMutex);
+            if (--remaining == 0) {
+                doneCondition.notify_all();
+            }
+        });
+    }
+
+    size_t helperQueue = nextQueue++ % queues.size();
+    while (remaining > 0 && tryRun(helperQueue)) {}
+
+    std::unique_lock<std::mutex> lock (doneMutex);
+    doneCondition.wait(lock, [&remaining]() { return remaining == 0; });
+}
@@ -0,0 +1,60 @@
+//
+//  ThreadPool.hpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::function<void()> Task;
+typedef std::function<void(size_t begin, size_t end)> RangeTask;
+
+// Work-stealing pool: every worker owns a deque, takes its own work from the
+// back and steals from the front of the others when it runs dry.
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queuedTasks {0};
+    std::atomic<size_t> nextQueue {0};
+    std::atomic<bool> stopping {false};
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    void push(size_t queueIndex, Task task);
+    bool tryRun(size_t preferredQueue);
+    void workerLoop(size_t queueIndex);
+public:
+    explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    void submit(Task task);
+
+    // Splits [0, count) into chunks of at least grain items, runs them on the
+    // pool and returns when all are done. The calling thread helps out.
+    // grain 0 picks a size giving each worker a few chunks to balance with.
+    void parallelFor(size_t count, size_t grain, const RangeTask& body);
+};
+
+#endif /* ThreadPool_hpp */
@@ -5,98 +5,306 @@
 //  Created by Egor Mikhailov on 03.09.2021.
 //
 
+#include "Instrumentation.hpp"
 #include "Tokenizer.hpp"
 #include "TypedExpression.hpp"
 
-#include <regex>
-#include <numeric>
-#include <iostream>
+#include <array>
 
 // MARK: - Basic building blocks
+//
+// The scanner is a DFA over the same lexemes the old regexes described:
+//   complex   [-+]?i | [-+]?i?((0|[1-9]\d*)|(0|[1-9]\d*)\.\d*)
+//   function  modulus | arg | power | root | exp | log
+//   operation [+-*/]
+//   space     " +"
+//   menu      A | B
+//   bracket   ( | )
+// Letters are matched case-insensitively.
 
-std::string signRe = "[-+]?";
-std::string integerRe = "[1-9]\\d*";
-std::string iRe = "i-i+i";
-std::string spacesRe = " +";
-std::string orRe = "|";
-std::string numberRe = "[-+]?i|[-+]?i?((0|[1-9]\\d*)|(0|[1-9]\\d*)\\.\\d*)";
-std::string signedNumberRe = signRe + numberRe;
-std::string menuSignsRe = "A|B";
+enum class CharClass: unsigned char {
+    OTHER,
+    SPACE,
+    SIGN,
+    MULTIPLICATIVE,
+    ZERO,
+    DIGIT,
+    DOT,
+    LETTER_I,
+    LETTER_M,
+    LETTER_O,
+    LETTER_D,
+    LETTER_U,
+    LETTER_L,
+    LETTER_S,
+    LETTER_A,
+    LETTER_R,
+    LETTER_G,
+    LETTER_B,
+    LETTER_P,
+    LETTER_W,
+    LETTER_E,
+    LETTER_T,
+    LETTER_X,
+    PARENTHESIS,
+    COUNT
+};
 
+enum class LexerState: unsigned char {
+    DEAD,
+    START,
+    SPACE,
+    SIGN,
+    OPERATION,
+    I,
+    ZERO,
+    INTEGER,
+    FRACTION,
+    M,
+    MO,
+    MOD,
+    MODU,
+    MODUL,
+    MODULU,
+    MODULUS,
+    A,
+    AR,
+    ARG,
+    P,
+    PO,
+    POW,
+    POWE,
+    POWER,
+    R,
+    RO,
+    ROO,
+    ROOT,
+    E,
+    EX,
+    EXP,
+    L,
+    LO,
+    LOG,
+    B,
+    PARENTHESIS,
+    COUNT
+};
 
-// MARK: - Posible lexemes
+enum class Lexeme: unsigned char {
+    NONE,
+    SPACE,
+    COMPLEX,
+    FUNCTION,
+    OPERATION,
+    MENU,
+    PARENTHESIS
+};
 
-std::regex complexRe = std::regex(numberRe, std::regex::icase);
-std::regex functionRe = std::regex("modulus" + orRe + "arg", std::regex::icase);
-std::regex operationRe = std::regex("[\\+\\-*\\/]", std::regex::icase);
-std::regex spaceRe = std::regex(spacesRe, std::regex::icase);
-std::regex menuRe = std::regex(menuSignsRe, std::regex::icase);
+constexpr size_t charClassCount = static_cast<size_t>(CharClass::COUNT);
+constexpr size_t lexerStateCount = static_cast<size_t>(LexerState::COUNT);
 
-bool isComplex(std::string& expression) {
-    return std::regex_match(expression, complexRe);
-}
+typedef std::array<CharClass, 256> CharClassTable;
+typedef std::array<std::array<LexerState, charClassCount>, lexerStateCount> TransitionTable;
+typedef std::array<Lexeme, lexerStateCount> AcceptTable;
+
+// MARK: - Table generation
 
-bool isOperator(std::string& expression) {
-    return std::regex_match(expression, operationRe);
+constexpr void setLetter(CharClassTable& table, char lower, CharClass charClass) {
+    table[static_cast<unsigned char>(lower)] = charClass;
+    table[static_cast<unsigned char>(lower - 'a' + 'A')] = charClass;
 }
 
-bool isFunction(std::string& expression) {
-    return std::regex_match(expression, functionRe);
+constexpr CharClassTable makeCharClasses() {
+    CharClassTable table {};
+    table[' '] = CharClass::SPACE;
+    table['+'] = CharClass::SIGN;
+    table['-'] = CharClass::SIGN;
+    table['*'] = CharClass::MULTIPLICATIVE;
+    table['/'] = CharClass::MULTIPLICATIVE;
+    table['0'] = CharClass::ZERO;
+    for (char digit = '1'; digit <= '9'; ++digit) {
+        table[static_cast<unsigned char>(digit)] = CharClass::DIGIT;
+    }
+    table['.'] = CharClass::DOT;
+    table['('] = CharClass::PARENTHESIS;
+    table[')'] = CharClass::PARENTHESIS;
+    setLetter(table, 'i', CharClass::LETTER_I);
+    setLetter(table, 'm', CharClass::LETTER_M);
+    setLetter(table, 'o', CharClass::LETTER_O);
+    setLetter(table, 'd', CharClass::LETTER_D);
+    setLetter(table, 'u', CharClass::LETTER_U);
+    setLetter(table, 'l', CharClass::LETTER_L);
+    setLetter(table, 's', CharClass::LETTER_S);
+    setLetter(table, 'a', CharClass::LETTER_A);
+    setLetter(table, 'r', CharClass::LETTER_R);
+    setLetter(table, 'g', CharClass::LETTER_G);
+    setLetter(table, 'b', CharClass::LETTER_B);
+    setLetter(table, 'p', CharClass::LETTER_P);
+    setLetter(table, 'w', CharClass::LETTER_W);
+    setLetter(table, 'e', CharClass::LETTER_E);
+    setLetter(table, 't', CharClass::LETTER_T);
+    setLetter(table, 'x', CharClass::LETTER_X);
+    return table;
 }
 
-bool isSpace(std::string& expression) {
-    return std::regex_match(expression, spaceRe);
+constexpr void setTransition(TransitionTable& table, LexerState from, CharClass on, LexerState to) {
+    table[static_cast<size_t>(from)][static_cast<size_t>(on)] = to;
 }
 
-bool isMenu(std::string& expression) {
-    return std::regex_match(expression, menuRe);
+constexpr TransitionTable makeTransitions() {
+    TransitionTable table {};
+
+    setTransition(table, LexerState::START, CharClass::SPACE, LexerState::SPACE);
+    setTransition(table, LexerState::SPACE, CharClass::SPACE, LexerState::SPACE);
+
+    setTransition(table, LexerState::START, CharClass::MULTIPLICATIVE, LexerState::OPERATION);
+    setTransition(table, LexerState::START, CharClass::SIGN, LexerState::SIGN);
+    setTransition(table, LexerState::SIGN, CharClass::LETTER_I, LexerState::I);
+    setTransition(table, LexerState::SIGN, CharClass::ZERO, LexerState::ZERO);
+    setTransition(table, LexerState::SIGN, CharClass::DIGIT, LexerState::INTEGER);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_I, LexerState::I);
+    setTransition(table, LexerState::START, CharClass::ZERO, LexerState::ZERO);
+    setTransition(table, LexerState::START, CharClass::DIGIT, LexerState::INTEGER);
+    setTransition(table, LexerState::I, CharClass::ZERO, LexerState::ZERO);
+    setTransition(table, LexerState::I, CharClass::DIGIT, LexerState::INTEGER);
+    setTransition(table, LexerState::ZERO, CharClass::DOT, LexerState::FRACTION);
+    setTransition(table, LexerState::INTEGER, CharClass::ZERO, LexerState::INTEGER);
+    setTransition(table, LexerState::INTEGER, CharClass::DIGIT, LexerState::INTEGER);
+    setTransition(table, LexerState::INTEGER, CharClass::DOT, LexerState::FRACTION);
+    setTransition(table, LexerState::FRACTION, CharClass::ZERO, LexerState::FRACTION);
+    setTransition(table, LexerState::FRACTION, CharClass::DIGIT, LexerState::FRACTION);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_M, LexerState::M);
+    setTransition(table, LexerState::M, CharClass::LETTER_O, LexerState::MO);
+    setTransition(table, LexerState::MO, CharClass::LETTER_D, LexerState::MOD);
+    setTransition(table, LexerState::MOD, CharClass::LETTER_U, LexerState::MODU);
+    setTransition(table, LexerState::MODU, CharClass::LETTER_L, LexerState::MODUL);
+    setTransition(table, LexerState::MODUL, CharClass::LETTER_U, LexerState::MODULU);
+    setTransition(table, LexerState::MODULU, CharClass::LETTER_S, LexerState::MODULUS);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_A, LexerState::A);
+    setTransition(table, LexerState::A, CharClass::LETTER_R, LexerState::AR);
+    setTransition(table, LexerState::AR, CharClass::LETTER_G, LexerState::ARG);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_P, LexerState::P);
+    setTransition(table, LexerState::P, CharClass::LETTER_O, LexerState::PO);
+    setTransition(table, LexerState::PO, CharClass::LETTER_W, LexerState::POW);
+    setTransition(table, LexerState::POW, CharClass::LETTER_E, LexerState::POWE);
+    setTransition(table, LexerState::POWE, CharClass::LETTER_R, LexerState::POWER);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_R, LexerState::R);
+    setTransition(table, LexerState::R, CharClass::LETTER_O, LexerState::RO);
+    setTransition(table, LexerState::RO, CharClass::LETTER_O, LexerState::ROO);
+    setTransition(table, LexerState::ROO, CharClass::LETTER_T, LexerState::ROOT);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_E, LexerState::E);
+    setTransition(table, LexerState::E, CharClass::LETTER_X, LexerState::EX);
+    setTransition(table, LexerState::EX, CharClass::LETTER_P, LexerState::EXP);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_L, LexerState::L);
+    setTransition(table, LexerState::L, CharClass::LETTER_O, LexerState::LO);
+    setTransition(table, LexerState::LO, CharClass::LETTER_G, LexerState::LOG);
+
+    setTransition(table, LexerState::START, CharClass::LETTER_B, LexerState::B);
+
+    setTransition(table, LexerState::START, CharClass::PARENTHESIS, LexerState::PARENTHESIS);
+
+    return table;
 }
 
-std::optional<Token> getNextToken(std::string::iterator& begin, std::string::iterator& end) {
-    std::string expression (begin, end);
-
-    if (isSpace(expression)) {
-        return std::make_optional(TypedExpression<SpaceExpr> (expression));
-    } else if (isComplex(expression)) {
-        return std::make_optional(TypedExpression<ComplexExpr> (expression));
-    } else if (isFunction(expression)) {
-        return std::make_optional(TypedExpression<FunctionExpr> (expression));
-    } else if (isOperator(expression)) {
-        return std::make_optional(TypedExpression<OperationExpr> (expression));
-    } else if (isMenu(expression)) {
-        return std::make_optional(TypedExpression<MenuExpr> (expression));
-    } else {
-        return std::nullopt;
-    }
+constexpr AcceptTable makeAccepts() {
+    AcceptTable table {};
+    table[static_cast<size_t>(LexerState::SPACE)] = Lexeme::SPACE;
+    table[static_cast<size_t>(LexerState::SIGN)] = Lexeme::OPERATION;
+    table[static_cast<size_t>(LexerState::OPERATION)] = Lexeme::OPERATION;
+    table[static_cast<size_t>(LexerState::I)] = Lexeme::COMPLEX;
+    table[static_cast<size_t>(LexerState::ZERO)] = Lexeme::COMPLEX;
+    table[static_cast<size_t>(LexerState::INTEGER)] = Lexeme::COMPLEX;
+    table[static_cast<size_t>(LexerState::FRACTION)] = Lexeme::COMPLEX;
+    table[static_cast<size_t>(LexerState::MODULUS)] = Lexeme::FUNCTION;
+    table[static_cast<size_t>(LexerState::ARG)] = Lexeme::FUNCTION;
+    table[static_cast<size_t>(LexerState::POWER)] = Lexeme::FUNCTION;
+    table[static_cast<size_t>(LexerState::ROOT)] = Lexeme::FUNCTION;
+    table[static_cast<size_t>(LexerState::EXP)] = Lexeme::FUNCTION;
+    table[static_cast<size_t>(LexerState::LOG)] = Lexeme::FUNCTION;
+    table[static_cast<size_t>(LexerState::A)] = Lexeme::MENU;
+    table[static_cast<size_t>(LexerState::B)] = Lexeme::MENU;
+    table[static_cast<size_t>(LexerState::PARENTHESIS)] = Lexeme::PARENTHESIS;
+    return table;
 }
 
-bool shouldPushBack(std::optional<Token> token, std::optional<Token> nextToken) {
-    return token.has_value() && !nextToken.has_value();
+// MARK: - Posible lexemes
+
+constexpr CharClassTable charClasses = makeCharClasses();
+constexpr TransitionTable transitions = makeTransitions();
+constexpr AcceptTable accepts = makeAccepts();
+
+LexerState nextState(LexerState state, char symbol) {
+    auto charClass = charClasses[static_cast<unsigned char>(symbol)];
+    return transitions[static_cast<size_t>(state)][static_cast<size_t>(charClass)];
 }
 
-std::vector<Token> Tokenizer::tokenize(std::string& input) {
-    std::string::iterator bufferBegin = input.begin();
-    std::string::iterator bufferEnd = bufferBegin + 1;
-    std::optional<Token> token = std::nullopt;
-    std::vector<Token> tokens {};
-
-    while (bufferEnd <= input.end()) {
-        auto nextToken = getNextToken(bufferBegin, bufferEnd);
-        if (shouldPushBack(token, nextToken)) {
-            bufferBegin = bufferEnd - 1;
-            tokens.push_back(token.value());
-        } else {
-            bufferEnd += 1;
-        }
-        token = nextToken;
+Token makeToken(Lexeme lexeme, std::string_view expression, size_t position) {
+    switch (lexeme) {
+        case Lexeme::SPACE:
+            return TypedExpression<SpaceExpr>(expression, position);
+        case Lexeme::COMPLEX:
+            return TypedExpression<ComplexExpr>(expression, position);
+        case Lexeme::FUNCTION:
+            return TypedExpression<FunctionExpr>(expression, position);
+        case Lexeme::OPERATION:
+            return TypedExpression<OperationExpr>(expression, position);
+        case Lexeme::MENU:
+            return TypedExpression<MenuExpr>(expression, position);
+        case Lexeme::PARENTHESIS:
+            return TypedExpression<ParenthesisExpr>(expression, position);
+        case Lexeme::NONE:
+            break;
     }
+    return TypedExpression<ErrorExpr>(expression, position);
+}
 
-    if (!token.has_value()) {
-        auto expr = std::string(bufferBegin, input.end());
-        token = TypedExpression<ErrorExpr>(expr);
+// Longest match from every position. The only non-accepting states on the way
+// to an accepting one are the keyword prefixes, so the lookahead that gets
+// rolled back is bounded by "modulus" and the whole scan stays linear.
+TokenList Tokenizer::tokenize(std::string_view input, std::pmr::memory_resource* resource) const {
+    StageTimer timer (Stage::TOKENIZE);
+    TokenList tokens (resource);
+
+    if (input.empty()) {
+        tokens.push_back(TypedExpression<ErrorExpr>(input));
+        Metrics::count(Counter::TOKENS);
+        return tokens;
     }
 
-    tokens.push_back(token.value());
+    size_t begin = 0;
+    while (begin < input.size()) {
+        auto state = LexerState::START;
+        auto lexeme = Lexeme::NONE;
+        size_t end = begin;
+
+        for (size_t position = begin; position < input.size(); ++position) {
+            state = nextState(state, input[position]);
+            if (state == LexerState::DEAD) {
+                break;
+            }
+            auto accepted = accepts[static_cast<size_t>(state)];
+            if (accepted != Lexeme::NONE) {
+                lexeme = accepted;
+                end = position + 1;
+            }
+        }
+
+        if (lexeme == Lexeme::NONE) {
+            tokens.push_back(TypedExpression<ErrorExpr>(input.substr(begin), begin));
+            break;
+        }
+
+        tokens.push_back(makeToken(lexeme, input.substr(begin, end - begin), begin));
+        begin = end;
+    }
 
+    Metrics::count(Counter::TOKENS, tokens.size());
     return tokens;
 }
@@ -8,7 +8,9 @@
 #ifndef Tokenizer_hpp
 #define Tokenizer_hpp
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <variant>
@@ -21,12 +23,31 @@ typedef std::variant<
     TypedExpression<FunctionExpr>,
     TypedExpression<SpaceExpr>,
     TypedExpression<MenuExpr>,
+    TypedExpression<ParenthesisExpr>,
     TypedExpression<ErrorExpr>
 >
 Token;
 
+// Polymorphic allocator, so a line's tokens can live in a RequestArena.
+typedef std::pmr::vector<Token> TokenList;
+
+inline size_t tokenPosition(const Token& token) {
+    return std::visit([](const auto& expression) { return expression.position; }, token);
+}
+
+// The column just past the token.
+inline size_t tokenEndPosition(const Token& token) {
+    return std::visit([](const auto& expression) { return expression.position + expression.expression.size(); }, token);
+}
+
+// Holds no state: the DFA tables are constexpr, so one Tokenizer may be
+// used from any number of threads at once. Everything a call produces is
+// in the returned list, allocated from the caller's resource.
 struct Tokenizer {
-    std::vector<Token> tokenize(std::string& input);
+    // Single pass longest-match scanner, O(n) in the input length.
+    // Tokens refer into input, which must stay alive while they are used.
+    // The list allocates from resource.
+    TokenList tokenize(std::string_view input, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
 };
 
 #endif /* Tokenizer_hpp */
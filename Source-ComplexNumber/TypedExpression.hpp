@@ -8,15 +8,18 @@
 #ifndef TypedExpression_hpp
 #define TypedExpression_hpp
 
-#include <string>
+#include <cstddef>
+#include <string_view>
 #include <optional>
 
+// A slice of the tokenized input. The expression is not owned, so the
+// input buffer has to outlive the token; position is the offset of the
+// slice in that buffer.
 template <typename StringType>
 struct TypedExpression {
-    std::string expression;
-    TypedExpression(std::string& expression) {
-        this->expression = expression;
-    }
+    std::string_view expression;
+    size_t position;
+    TypedExpression(std::string_view expression, size_t position = 0): expression(expression), position(position) {};
 };
 
 struct ComplexExpr {};
@@ -24,6 +27,7 @@ struct OperationExpr {};
 struct FunctionExpr {};
 struct SpaceExpr {};
 struct MenuExpr {};
+struct ParenthesisExpr {};
 struct ErrorExpr {};
 
 #endif /* TypedExpression_hpp */
@@ -5,11 +5,294 @@
 //  Created by Egor Mikhailov on 21.04.2021.
 //
 
+#include <algorithm>
+#include <charconv>
+#include <csignal>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+
 #include "Console.hpp"
+#include "Batch.hpp"
+#include "Instrumentation.hpp"
+#include "MappedFile.hpp"
+#include "Server.hpp"
 
 using namespace std;
 
-int main() {
+// The whole of text as a count, or nothing for anything else, a sign
+// included.
+optional<size_t> parseCount(string_view text) {
+    size_t count = 0;
+    auto last = text.data() + text.size();
+    auto parsed = from_chars(text.data(), last, count);
+    if (text.empty() || parsed.ec != errc() || parsed.ptr != last) {
+        return nullopt;
+    }
+    return count;
+}
+
+// Usage: calculator                          interactive console
+//        calculator --batch [options] [file]  one "operand operation operand" per line
+//        calculator --eval [options] [file]   one arithmetic expression per line
+//        calculator --serve [options] <address>  --eval's lines (--batch's with --batch) for clients of a
+//                                             Unix socket at path address, or of loopback TCP at "tcp:<port>",
+//                                             until SIGINT or SIGTERM
+// Options: --cache=<entries>  parsed lines to keep, 0 disables the cache
+//          --cache-stats      print cache hits, misses and evictions to stderr
+//          --precision=<float|double|long-double>  scalar type to parse and calculate with
+//          --pipeline         --batch only: lex, parse, calculate and print on separate threads
+//          --mmap             map the file instead of reading it and evaluate it in parallel chunks
+//          --output=<text|binary>  results as lines, or as a complex stream (see ComplexStream.hpp)
+//          --input=<text|binary>   lines, or a complex stream of first operands for --apply
+//          --apply=<operation>     --input=binary only: e.g. "* 2", "power 3" or "+ 1-i", none by default
+//          --threads=<n>      --serve only: evaluating workers, one per core by default
+// In any mode, with a build that has -DCOMPLEX_NUMBER_INSTRUMENTATION:
+//          --metrics=<path>   dump stage latencies and counters to path on exit and on SIGUSR1
+//          --metrics-format=<json|prometheus>  format of the dump, json by default
+//          --metrics-sampling=<n>  time one call in n per stage, 16 by default in --batch and --eval, 1 otherwise
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+
+    string metricsPath;
+    auto metricsFormat = MetricsFormat::JSON;
+    unsigned long samplingInterval = mode == "--batch" || mode == "--eval" ? 16 : 1;
+    for (int index = 1; index < argc; ++index) {
+        string argument = argv[index];
+        if (argument.rfind("--metrics=", 0) == 0) {
+            metricsPath = argument.substr(10);
+        } else if (argument == "--metrics-format=json") {
+            metricsFormat = MetricsFormat::JSON;
+        } else if (argument == "--metrics-format=prometheus") {
+            metricsFormat = MetricsFormat::PROMETHEUS;
+        } else if (argument.rfind("--metrics-sampling=", 0) == 0) {
+            auto interval = parseCount(argument.substr(19));
+            if (!interval.has_value()) {
+                cerr << "Invalid metrics sampling " << argument.substr(19) << endl;
+                return 1;
+            }
+            samplingInterval = max<unsigned long>(interval.value(), 1);
+        } else if (argument.rfind("--metrics-format=", 0) == 0) {
+            cerr << "Unknown metrics format " << argument.substr(17) << endl;
+            return 1;
+        }
+    }
+    if (!metricsPath.empty()) {
+        if (!instrumentationEnabled) {
+            cerr << "--metrics needs a build with -DCOMPLEX_NUMBER_INSTRUMENTATION" << endl;
+            return 1;
+        }
+        Metrics::samplingInterval = samplingInterval;
+        dumpMetrics(metricsPath, metricsFormat);
+    }
+
+    if (mode == "--batch" || mode == "--eval") {
+        ios::sync_with_stdio(false);
+        auto batch = Batch(mode == "--eval" ? BatchMode::EXPRESSION : BatchMode::OPERATION);
+        bool printStatistics = false;
+        bool mapped = false;
+        bool isBinaryInput = false;
+        string operation;
+        string path;
+
+        for (int index = 2; index < argc; ++index) {
+            string argument = argv[index];
+            if (argument.rfind("--metrics", 0) == 0) {
+                continue;
+            } else if (argument.rfind("--cache=", 0) == 0) {
+                auto capacity = parseCount(argument.substr(8));
+                if (!capacity.has_value()) {
+                    cerr << "Invalid cache size " << argument.substr(8) << endl;
+                    return 1;
+                }
+                batch.cacheCapacity = capacity.value();
+            } else if (argument == "--cache-stats") {
+                printStatistics = true;
+            } else if (argument == "--precision=float") {
+                batch.precision = Precision::FLOAT;
+            } else if (argument == "--precision=double") {
+                batch.precision = Precision::DOUBLE;
+            } else if (argument == "--precision=long-double") {
+                batch.precision = Precision::LONG_DOUBLE;
+            } else if (argument == "--pipeline") {
+                batch.pipelined = true;
+            } else if (argument == "--mmap") {
+                mapped = true;
+            } else if (argument == "--output=text") {
+                batch.outputFormat = BatchFormat::TEXT;
+            } else if (argument == "--output=binary") {
+                batch.outputFormat = BatchFormat::BINARY;
+            } else if (argument == "--input=text") {
+                isBinaryInput = false;
+            } else if (argument == "--input=binary") {
+                isBinaryInput = true;
+            } else if (argument.rfind("--apply=", 0) == 0) {
+                operation = argument.substr(8);
+            } else if (argument.rfind("--precision=", 0) == 0) {
+                cerr << "Unknown precision " << argument.substr(12) << endl;
+                return 1;
+            } else if (argument.rfind("--output=", 0) == 0 || argument.rfind("--input=", 0) == 0) {
+                cerr << "Unknown format " << argument.substr(argument.find('=') + 1) << endl;
+                return 1;
+            } else if (argument.rfind("--", 0) == 0) {
+                cerr << "Unknown option " << argument << endl;
+                return 1;
+            } else {
+                path = argument;
+            }
+        }
+
+        if (batch.pipelined && batch.mode != BatchMode::OPERATION) {
+            cerr << "--pipeline works with --batch only" << endl;
+            return 1;
+        }
+        if (batch.pipelined && (batch.outputFormat == BatchFormat::BINARY || isBinaryInput)) {
+            cerr << "--pipeline reads and writes text only" << endl;
+            return 1;
+        }
+        if (!operation.empty() && !isBinaryInput) {
+            cerr << "--apply works with --input=binary only" << endl;
+            return 1;
+        }
+
+        if (isBinaryInput) {
+            // Mapped, the numbers are read in place; otherwise the whole
+            // stream is read into memory first.
+            string contents;
+            string_view bytes;
+            optional<MappedFile> file;
+            if (mapped) {
+                if (path.empty()) {
+                    cerr << "--mmap needs a file" << endl;
+                    return 1;
+                }
+                auto opened = MappedFile::open(path);
+                if (opened.hasError()) {
+                    cerr << "Can't map " << path << ": " << opened.error().description << endl;
+                    return 1;
+                }
+                file = std::move(opened).success();
+                bytes = file->contents();
+            } else {
+                ifstream stream;
+                if (!path.empty()) {
+                    stream.open(path, ios::binary);
+                    if (!stream) {
+                        cerr << "Can't open " << path << endl;
+                        return 1;
+                    }
+                }
+                istream& input = path.empty() ? cin : stream;
+                contents.assign(istreambuf_iterator<char>(input), istreambuf_iterator<char>());
+                bytes = contents;
+            }
+
+            auto numbers = ComplexStreamView::parse(bytes);
+            if (numbers.hasError()) {
+                cerr << "Can't read " << (path.empty() ? "input" : path) << ": " << numbers.error().description << endl;
+                return 1;
+            }
+            auto count = batch.run(numbers.success(), operation, cout);
+            if (count.hasError()) {
+                cerr << "Invalid --apply: " << count.error().description;
+                if (count.error().position.has_value()) {
+                    cerr << " at column " << count.error().position.value() + 1;
+                }
+                cerr << endl;
+                return 1;
+            }
+            return 0;
+        }
+
+        if (mapped) {
+            if (path.empty()) {
+                cerr << "--mmap needs a file" << endl;
+                return 1;
+            }
+            auto file = MappedFile::open(path);
+            if (file.hasError()) {
+                cerr << "Can't map " << path << ": " << file.error().description << endl;
+                return 1;
+            }
+            batch.run(file.success().contents(), cout);
+        } else if (!path.empty()) {
+            ifstream file (path);
+            if (!file) {
+                cerr << "Can't open " << path << endl;
+                return 1;
+            }
+            batch.run(file, cout);
+        } else {
+            batch.run(cin, cout);
+        }
+
+        if (printStatistics) {
+            cerr << "cache hits " << batch.statistics.hits << ", misses " << batch.statistics.misses << ", evictions " << batch.statistics.evictions << endl;
+        }
+        return 0;
+    }
+
+    if (mode == "--serve") {
+        Server server;
+        string address;
+
+        for (int index = 2; index < argc; ++index) {
+            string argument = argv[index];
+            if (argument.rfind("--metrics", 0) == 0) {
+                continue;
+            } else if (argument == "--batch") {
+                server.mode = BatchMode::OPERATION;
+            } else if (argument.rfind("--cache=", 0) == 0) {
+                auto capacity = parseCount(argument.substr(8));
+                if (!capacity.has_value()) {
+                    cerr << "Invalid cache size " << argument.substr(8) << endl;
+                    return 1;
+                }
+                server.cacheCapacity = capacity.value();
+            } else if (argument.rfind("--threads=", 0) == 0) {
+                auto threadCount = parseCount(argument.substr(10));
+                if (!threadCount.has_value()) {
+                    cerr << "Invalid thread count " << argument.substr(10) << endl;
+                    return 1;
+                }
+                server.threadCount = max<size_t>(threadCount.value(), 1);
+            } else if (argument == "--precision=float") {
+                server.precision = Precision::FLOAT;
+            } else if (argument == "--precision=double") {
+                server.precision = Precision::DOUBLE;
+            } else if (argument == "--precision=long-double") {
+                server.precision = Precision::LONG_DOUBLE;
+            } else if (argument.rfind("--precision=", 0) == 0) {
+                cerr << "Unknown precision " << argument.substr(12) << endl;
+                return 1;
+            } else if (argument.rfind("--", 0) == 0) {
+                cerr << "Unknown option " << argument << endl;
+                return 1;
+            } else {
+                address = argument;
+            }
+        }
+
+        if (address.empty()) {
+            cerr << "--serve needs an address" << endl;
+            return 1;
+        }
+        auto bound = server.listen(address);
+        if (bound.hasError()) {
+            cerr << "Can't serve: " << bound.error().description << endl;
+            return 1;
+        }
+        cerr << "Serving on " << bound.success() << endl;
+
+        static Server* running = &server;
+        signal(SIGINT, [](int) { running->stop(); });
+        signal(SIGTERM, [](int) { running->stop(); });
+        server.run();
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
     auto console = Console();
     console.start();
 
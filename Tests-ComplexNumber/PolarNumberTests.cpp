@@ -0,0 +1,99 @@
+//
+//  PolarNumberTests.cpp
+//  ComplexNumberClass
+//
+//  Created by Egor Mikhailov on 17.10.2026.
+//
+//  Powers and roots at the edges of the exponent range: NaN, infinities,
+//  exponents far outside long and a root of degree 0, which is a power of
+//  infinity. None of them may take the integer power path, whose cast to
+//  long would be undefined; build with -fsanitize=float-cast-overflow to
+//  have that checked too.
+//  Build: cmake --build <build directory> --target polar-tests
+//  Run: ctest, or ./polar-tests
+//
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "../Source-ComplexNumber/PolarNumber.hpp"
+
+size_t failures = 0;
+
+void check(bool condition, const std::string& description) {
+    if (!condition) {
+        std::cerr << "failed: " << description << std::endl;
+        failures += 1;
+    }
+}
+
+// MARK: - Checks
+
+void checkSquaringExponents() {
+    const double infinity = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    check(isSquaringExponent(0.0), "0 is squared");
+    check(isSquaringExponent(-3.0), "-3 is squared");
+    check(isSquaringExponent(64.0), "64 is squared");
+    check(!isSquaringExponent(65.0), "65 is not squared");
+    check(!isSquaringExponent(2.5), "2.5 is not squared");
+    check(!isSquaringExponent(nan), "NaN is not squared");
+    check(!isSquaringExponent(infinity), "inf is not squared");
+    check(!isSquaringExponent(-infinity), "-inf is not squared");
+    check(!isSquaringExponent(1e300), "1e300 is not squared");
+    check(!isSquaringExponent(-1e300), "-1e300 is not squared");
+    check(!isSquaringExponent(std::numeric_limits<float>::infinity()), "float inf is not squared");
+    check(!isSquaringExponent(std::numeric_limits<long double>::quiet_NaN()), "long double NaN is not squared");
+}
+
+void checkPolarPowers() {
+    const double infinity = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const PolarNumber small (0.5, 0.25);
+    const PolarNumber large (2, 0.25);
+
+    check(std::isnan(small.power(nan).modulus()), "power(NaN) has a NaN modulus");
+    check(small.power(infinity).modulus() == 0, "0.5 power(inf) is 0");
+    check(large.power(infinity).modulus() == infinity, "2 power(inf) is inf");
+    check(small.power(1e300).modulus() == 0, "0.5 power(1e300) is 0");
+    check(large.power(-1e300).modulus() == 0, "2 power(-1e300) is 0");
+    check(small.root(0).modulus() == 0, "0.5 root(0) is 0");
+    check(large.root(0).modulus() == infinity, "2 root(0) is inf");
+    check(large.power(3).modulus() == 8 && large.power(3).getAngle() == 0.75, "2 power(3) is squared");
+}
+
+void checkLazyPowers() {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const ComplexNumber base (0.5, 0.5);
+
+    auto lazyPower = [&](double exponent) {
+        return LazyComplexNumber(base).power(LazyComplexNumber(ComplexNumber(exponent, 0)));
+    };
+    auto power = [&](double exponent) {
+        return lazyPower(exponent).cartesianForm();
+    };
+    auto isNaN = [](const ComplexNumber& number) {
+        return std::isnan(number.getReal()) && std::isnan(number.getImaginary());
+    };
+
+    check(isNaN(power(nan)), "lazy power(NaN) is NaN");
+    // An infinite angle has no cartesian form, so these check the modulus.
+    check(lazyPower(std::numeric_limits<double>::infinity()).modulus() == 0, "lazy power(inf) has modulus 0");
+    check(lazyPower(1e300).modulus() == 0, "lazy power(1e300) has modulus 0");
+    check(LazyComplexNumber(base).root(LazyComplexNumber(ComplexNumber(0, 0))).modulus() == 0, "lazy root(0) has modulus 0");
+    check(power(2).getReal() == 0 && power(2).getImaginary() == 0.5, "lazy power(2) is exact");
+}
+
+// MARK: - Entry Point
+
+int main() {
+    checkSquaringExponents();
+    checkPolarPowers();
+    checkLazyPowers();
+
+    std::cout << (failures == 0 ? "all passed" : std::to_string(failures) + " failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}